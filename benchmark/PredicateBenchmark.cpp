@@ -0,0 +1,137 @@
+#include "../inc/InputGenerator.h"
+#include "include/CPU/PredWrapper.h"
+
+namespace
+{
+constexpr int DefaultPointNum = 100000;
+constexpr int DefaultRepeat   = 20;
+
+const std::vector<std::string> distributionNames{"Uniform", "Grid", "Circle", "ThinCircle", "TwoLines"};
+
+struct BenchResult
+{
+    std::string predicate;
+    double      nsPerCall    = 0;
+    double      fallbackRate = -1; // Negative if the predicate has no exact stage
+};
+
+// Keeps the optimizer from dropping the predicate calls
+volatile long long sink = 0;
+
+template <typename Func>
+double timeLoop(int repeat, int tupleNum, Func func)
+{
+    gdg::PerfTimer timer;
+    long long      sum = 0;
+
+    timer.start();
+    for (int r = 0; r < repeat; ++r)
+        for (int i = 0; i < tupleNum; ++i)
+            sum += func(i);
+    timer.stop();
+
+    sink = sink + sum;
+    return timer.value() * 1e6 / ((double)repeat * tupleNum);
+}
+
+template <typename Func>
+double countRate(int tupleNum, Func isFallback)
+{
+    int count = 0;
+    for (int i = 0; i < tupleNum; ++i)
+        if (isFallback(i))
+            ++count;
+    return (double)count / tupleNum;
+}
+
+std::vector<BenchResult> benchDistribution(const gdg::Point2DHVec &pointVec, int repeat)
+{
+    // Consecutive points in sorted order form the tuples, so they are close
+    // to each other like the ones met during triangulation
+    gdg::Point2DHVec sortedVec = pointVec;
+    std::sort(sortedVec.begin(), sortedVec.end());
+
+    const gdg::Point      *pts      = sortedVec.data();
+    const int              tupleNum = (int)sortedVec.size() - 3;
+    const gdg::PredWrapper predWrapper(sortedVec, gdg::Point());
+
+    std::vector<BenchResult> results;
+
+    auto orient = [&](int i) { return gdg::orient2d(pts[i]._p, pts[i + 1]._p, pts[i + 2]._p); };
+    auto orientZero = [&](int i) { return gdg::orient2dzero(pts[i]._p, pts[i + 1]._p, pts[i + 2]._p); };
+    auto circle = [&](int i) { return gdg::incircle(pts[i]._p, pts[i + 1]._p, pts[i + 2]._p, pts[i + 3]._p); };
+    auto circleFast = [&](int i) {
+        return gdg::incirclefast(pts[i]._p, pts[i + 1]._p, pts[i + 2]._p, pts[i + 3]._p);
+    };
+    auto circleZero = [&](int i) {
+        return gdg::incirclezero(pts[i]._p, pts[i + 1]._p, pts[i + 2]._p, pts[i + 3]._p);
+    };
+
+    results.push_back({"orient2d",
+                       timeLoop(repeat, tupleNum, [&](int i) { return orient(i) > 0; }),
+                       countRate(tupleNum, [&](int i) { return orientZero(i) == 0; })});
+    results.push_back({"orient2dzero", timeLoop(repeat, tupleNum, [&](int i) { return orientZero(i) > 0; })});
+    results.push_back({"incircle",
+                       timeLoop(repeat, tupleNum, [&](int i) { return circle(i) > 0; }),
+                       countRate(tupleNum, [&](int i) { return circleZero(i) == 0; })});
+    results.push_back({"incirclefast", timeLoop(repeat, tupleNum, [&](int i) { return circleFast(i) > 0; })});
+    results.push_back({"doOrient2DFastExactSoS",
+                       timeLoop(repeat,
+                                tupleNum,
+                                [&](int i) {
+                                    return (int)predWrapper.doOrient2DFastExactSoS<gdg::HasInf::No>(i, i + 1, i + 2);
+                                }),
+                       countRate(tupleNum, [&](int i) { return orient(i) == 0; })});
+    results.push_back({"doIncircle",
+                       timeLoop(repeat,
+                                tupleNum,
+                                [&](int i) {
+                                    return (int)predWrapper.doIncircle<gdg::HasInf::No>({i, i + 1, i + 2}, i + 3);
+                                }),
+                       countRate(tupleNum, [&](int i) { return circleZero(i) == 0; })});
+
+    return results;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 3)
+    {
+        std::cerr << "Usage: ./predicate-benchmark [point_num] [repeat]" << std::endl;
+        return -1;
+    }
+
+    const int pointNum = (argc > 1) ? std::stoi(argv[1]) : DefaultPointNum;
+    const int repeat   = (argc > 2) ? std::stoi(argv[2]) : DefaultRepeat;
+
+    gdg::exactinit();
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(14) << "Distribution" << std::setw(24) << "Predicate" << std::right
+              << std::setw(10) << "ns/call" << std::setw(12) << "Fallback %" << std::endl;
+
+    for (const auto &name : distributionNames)
+    {
+        InputGeneratorOption option;
+        option.pointNum = pointNum;
+        option.setDistributionFromStr(name);
+
+        gdg::Input     input;
+        InputGenerator inputGenerator(option, input);
+        inputGenerator.generateInput();
+
+        for (const auto &result : benchDistribution(input.pointVec, repeat))
+        {
+            std::cout << std::left << std::setw(14) << name << std::setw(24) << result.predicate << std::right
+                      << std::setw(10) << result.nsPerCall;
+            if (result.fallbackRate < 0)
+                std::cout << std::setw(12) << "-";
+            else
+                std::cout << std::setw(12) << result.fallbackRate * 100;
+            std::cout << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,330 @@
+#include "../inc/InputGenerator.h"
+#include "../inc/json.h"
+#include "include/HostParallel.h"
+#include <ctime>
+#include <sys/utsname.h>
+#include <unistd.h>
+#include <yaml-cpp/yaml.h>
+
+#ifndef GDG_GIT_REVISION
+#define GDG_GIT_REVISION "unknown"
+#endif
+
+namespace
+{
+// Every combination of the lists is run
+struct SweepOption
+{
+    std::vector<int>          pointNums{100000};
+    std::vector<std::string>  distributions{"Uniform"};
+    std::vector<bool>         insertAlls{false};
+    std::vector<bool>         noSortPoints{false};
+    std::vector<bool>         noReorders{false};
+    std::vector<int>          devices{-1}; // -1 picks the fastest device
+    int                       seed      = 76213898;
+    int                       warmupNum = 1;
+    int                       runNum    = 5;
+    ConstraintGeneratorOption constraintOption;
+    std::string               csvFilename;
+    std::string               jsonFilename;
+
+    explicit SweepOption(const YAML::Node &config);
+};
+
+struct BenchCase
+{
+    int         device = 0;
+    std::string distribution;
+    int         pointNum  = 0;
+    bool        insAll    = false;
+    bool        noSort    = false;
+    bool        noReorder = false;
+};
+
+struct BenchResult
+{
+    BenchCase              benchCase;
+    size_t                 inputPointNum = 0; // After duplicates are removed, with constraint vertices
+    size_t                 constraintNum = 0;
+    size_t                 triNum        = 0;
+    gdg::StatisticsSummary summary; // Over the timed runs
+};
+
+// A key holds either one value or a list of them
+template <typename T>
+void readList(const YAML::Node &config, const char *key, std::vector<T> &list)
+{
+    if (!config[key])
+        return;
+    list.clear();
+    if (config[key].IsSequence())
+    {
+        for (const auto &item : config[key])
+            list.push_back(item.as<T>());
+    }
+    else
+    {
+        list.push_back(config[key].as<T>());
+    }
+    if (list.empty())
+        throw std::invalid_argument(std::string("Benchmark: ") + key + " is empty!");
+}
+
+SweepOption::SweepOption(const YAML::Node &config)
+{
+    readList(config, "PointNums", pointNums);
+    readList(config, "Distributions", distributions);
+    readList(config, "InsertAll", insertAlls);
+    readList(config, "NoSortPoint", noSortPoints);
+    readList(config, "NoReorder", noReorders);
+    readList(config, "Devices", devices);
+    if (config["Seed"])
+        seed = config["Seed"].as<int>();
+    if (config["WarmupRuns"])
+        warmupNum = std::max(0, config["WarmupRuns"].as<int>());
+    if (config["Runs"])
+        runNum = std::max(1, config["Runs"].as<int>());
+    if (config["ConstraintType"])
+    {
+        constraintOption.setShapeFromStr(config["ConstraintType"].as<std::string>());
+        constraintOption.constraintNum = config["ConstraintNum"].as<int>();
+        constraintOption.segmentNum    = config["ConstraintSegments"].as<int>();
+    }
+    if (config["CsvPath"])
+        csvFilename = config["CsvPath"].as<std::string>();
+    if (config["JsonPath"])
+        jsonFilename = config["JsonPath"].as<std::string>();
+
+    int deviceCount = 0;
+    CudaSafeCall(cudaGetDeviceCount(&deviceCount));
+    for (int &device : devices)
+    {
+        if (device < 0)
+            device = gdg::cutGetMaxGflopsDeviceId();
+        else if (device >= deviceCount)
+            throw std::invalid_argument("Benchmark: no CUDA device " + std::to_string(device) + "!");
+    }
+}
+
+std::string cpuModel()
+{
+    std::ifstream cpuInfo("/proc/cpuinfo");
+    std::string   line;
+    while (std::getline(cpuInfo, line))
+    {
+        if (line.compare(0, 10, "model name") == 0 && line.find(':') != std::string::npos)
+            return line.substr(line.find(':') + 2);
+    }
+    return "unknown";
+}
+
+nlohmann::ordered_json environmentInfo(const std::vector<int> &devices)
+{
+    nlohmann::ordered_json env;
+
+    char         timeStr[32];
+    const time_t now = time(nullptr);
+    strftime(timeStr, sizeof(timeStr), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+    env["timestamp"] = timeStr;
+
+    char hostname[256] = {};
+    gethostname(hostname, sizeof(hostname) - 1);
+    env["host"] = hostname;
+
+    utsname uts{};
+    if (uname(&uts) == 0)
+        env["os"] = std::string(uts.sysname) + " " + uts.release + " " + uts.machine;
+    env["cpu"]          = cpuModel();
+    env["hostThreads"]  = gdg::hostThreadNum();
+    env["compiler"]     = __VERSION__;
+    env["gitRevision"]  = GDG_GIT_REVISION;
+    env["profileLevel"] = PROFILE_LEVEL;
+
+    int driverVersion = 0, runtimeVersion = 0;
+    cudaDriverGetVersion(&driverVersion);
+    cudaRuntimeGetVersion(&runtimeVersion);
+    env["cudaDriver"]  = driverVersion;
+    env["cudaRuntime"] = runtimeVersion;
+
+    std::vector<int> uniqueDevices = devices;
+    std::sort(uniqueDevices.begin(), uniqueDevices.end());
+    uniqueDevices.erase(std::unique(uniqueDevices.begin(), uniqueDevices.end()), uniqueDevices.end());
+    for (const int device : uniqueDevices)
+    {
+        cudaDeviceProp properties{};
+        CudaSafeCall(cudaGetDeviceProperties(&properties, device));
+
+        nlohmann::ordered_json gpu;
+        gpu["device"]            = device;
+        gpu["name"]              = properties.name;
+        gpu["computeCapability"] = std::to_string(properties.major) + "." + std::to_string(properties.minor);
+        gpu["multiProcessors"]   = properties.multiProcessorCount;
+        gpu["memoryMB"]          = properties.totalGlobalMem >> 20;
+        gpu["clockMHz"]          = properties.clockRate / 1000;
+        env["gpus"].push_back(gpu);
+    }
+    return env;
+}
+
+BenchResult runCase(gdg::GpuDel &gpuDel, gdg::Input &input, const BenchCase &benchCase, int warmupNum, int runNum)
+{
+    input.insAll    = benchCase.insAll;
+    input.noSort    = benchCase.noSort;
+    input.noReorder = benchCase.noReorder;
+
+    gdg::Output            output;
+    gdg::StatisticsHistory history(warmupNum);
+    for (int i = 0; i < warmupNum + runNum; ++i)
+    {
+        output.reset();
+        gpuDel.compute(input, output);
+        history.add(gpuDel.getStatistics());
+    }
+
+    BenchResult result;
+    result.benchCase     = benchCase;
+    result.summary       = history.summarize();
+    result.inputPointNum = input.pointNum();
+    result.constraintNum = input.constraintNum();
+    result.triNum        = output.triNum();
+    return result;
+}
+
+void writeCsv(const std::string &filename, const nlohmann::ordered_json &env, const std::vector<BenchResult> &results)
+{
+    std::ofstream csv(filename);
+    if (!csv.is_open())
+        throw std::runtime_error("Benchmark: cannot write " + filename);
+
+    // Environment as comment lines, skipped by most CSV readers
+    for (const auto &item : env.items())
+        csv << "# " << item.key() << ": " << (item.value().is_string() ? item.value().get<std::string>()
+                                                                        : item.value().dump())
+            << "\n";
+
+    csv << "device,distribution,pointNum,insertAll,noSortPoint,noReorder,inputPointNum,constraintNum,triNum";
+    for (int s = 0; s < gdg::StatisticsStageNum; ++s)
+        for (int f = 0; f < gdg::StatisticsSummaryFieldNum; ++f)
+            csv << "," << gdg::statisticsStages()[s].name << gdg::statisticsSummaryFields()[f].name;
+    csv << "\n";
+
+    csv << std::fixed << std::setprecision(3);
+    for (const BenchResult &result : results)
+    {
+        const BenchCase &c = result.benchCase;
+        csv << c.device << "," << c.distribution << "," << c.pointNum << "," << c.insAll << "," << c.noSort << ","
+            << c.noReorder << "," << result.inputPointNum << "," << result.constraintNum << "," << result.triNum;
+        for (int s = 0; s < gdg::StatisticsStageNum; ++s)
+            for (int f = 0; f < gdg::StatisticsSummaryFieldNum; ++f)
+                csv << ","
+                    << (result.summary.*gdg::statisticsSummaryFields()[f].value).*gdg::statisticsStages()[s].time;
+        csv << "\n";
+    }
+}
+
+void writeJson(const std::string              &filename,
+               const nlohmann::ordered_json   &env,
+               const SweepOption              &sweep,
+               const std::vector<BenchResult> &results)
+{
+    nlohmann::ordered_json json;
+    json["environment"] = env;
+    json["warmupRuns"]  = sweep.warmupNum;
+    json["runs"]        = sweep.runNum;
+    json["seed"]        = sweep.seed;
+    json["results"]     = nlohmann::ordered_json::array();
+
+    for (const BenchResult &result : results)
+    {
+        const BenchCase       &c = result.benchCase;
+        nlohmann::ordered_json item;
+        item["device"]        = c.device;
+        item["distribution"]  = c.distribution;
+        item["pointNum"]      = c.pointNum;
+        item["insertAll"]     = c.insAll;
+        item["noSortPoint"]   = c.noSort;
+        item["noReorder"]     = c.noReorder;
+        item["inputPointNum"] = result.inputPointNum;
+        item["constraintNum"] = result.constraintNum;
+        item["triNum"]        = result.triNum;
+        for (int s = 0; s < gdg::StatisticsStageNum; ++s)
+        {
+            const gdg::StatisticsStage &stage = gdg::statisticsStages()[s];
+            for (int f = 0; f < gdg::StatisticsSummaryFieldNum; ++f)
+            {
+                const gdg::StatisticsSummaryField &field = gdg::statisticsSummaryFields()[f];
+                item["timeMs"][stage.name][field.name]   = (result.summary.*field.value).*stage.time;
+            }
+        }
+        json["results"].push_back(item);
+    }
+
+    std::ofstream file(filename);
+    if (!file.is_open())
+        throw std::runtime_error("Benchmark: cannot write " + filename);
+    file << json.dump(2) << std::endl;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: ./triangulation-benchmark benchmark.yaml" << std::endl;
+        return -1;
+    }
+
+    const SweepOption            sweep(YAML::LoadFile(argv[1]));
+    const nlohmann::ordered_json env = environmentInfo(sweep.devices);
+
+    std::vector<BenchResult> results;
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(8) << "Device" << std::setw(14) << "Distribution" << std::right
+              << std::setw(12) << "PointNum" << std::setw(8) << "InsAll" << std::setw(8) << "NoSort" << std::setw(10)
+              << "NoReorder" << std::setw(12) << "Total ms" << std::setw(12) << "P95 ms" << std::endl;
+
+    for (const int pointNum : sweep.pointNums)
+    {
+        for (const std::string &distribution : sweep.distributions)
+        {
+            // Each input is made once and triangulated under every setting
+            InputGeneratorOption option;
+            option.pointNum         = pointNum;
+            option.seed             = sweep.seed;
+            option.constraintOption = sweep.constraintOption;
+            option.setDistributionFromStr(distribution);
+
+            gdg::Input     input;
+            InputGenerator inputGenerator(option, input);
+            inputGenerator.generateInput();
+
+            for (const int device : sweep.devices)
+            {
+                CudaSafeCall(cudaSetDevice(device));
+                gdg::GpuDel gpuDel;
+
+                for (const bool insAll : sweep.insertAlls)
+                    for (const bool noSort : sweep.noSortPoints)
+                        for (const bool noReorder : sweep.noReorders)
+                        {
+                            const BenchCase benchCase{device, distribution, pointNum, insAll, noSort, noReorder};
+                            results.push_back(runCase(gpuDel, input, benchCase, sweep.warmupNum, sweep.runNum));
+
+                            std::cout << std::left << std::setw(8) << device << std::setw(14) << distribution
+                                      << std::right << std::setw(12) << pointNum << std::setw(8) << insAll
+                                      << std::setw(8) << noSort << std::setw(10) << noReorder << std::setw(12)
+                                      << results.back().summary.mean.totalTime << std::setw(12)
+                                      << results.back().summary.p95.totalTime << std::endl;
+                        }
+            }
+        }
+    }
+
+    if (!sweep.csvFilename.empty())
+        writeCsv(sweep.csvFilename, env, results);
+    if (!sweep.jsonFilename.empty())
+        writeJson(sweep.jsonFilename, env, sweep, results);
+
+    return 0;
+}
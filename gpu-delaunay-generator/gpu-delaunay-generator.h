@@ -6,5 +6,6 @@
 #include "include/GPU/GpuDelaunay.h"
 #include "include/HashFunctors.h"
 #include "include/DelaunayChecker.h"
+#include "include/VertexTriIndex.h"
 
 #endif //EXAMPLE_GPU_DELAUNAY_GENERATOR_H
@@ -14,6 +14,19 @@ double orient2dzero(const double *pa, const double *pb, const double *pc);
 
 double incircle(const double *pa, const double *pb, const double *pc, const double *pd);
 
+double incirclefast(const double *pa, const double *pb, const double *pc, const double *pd);
+
+double incirclezero(const double *pa, const double *pb, const double *pc, const double *pd);
+
+// Whether the vertices passed to a predicate may include the infinity point.
+// Callers that partition finite and infinite triangles up front use HasInf::No
+// to get a predicate without any infinity check.
+enum class HasInf
+{
+    No,
+    Yes
+};
+
 class PredWrapper
 {
   private:
@@ -28,14 +41,39 @@ class PredWrapper
     size_t _infIdx;
 
     PredWrapper(const Point2DHVec &pointVec, Point ptInfty);
+    PredWrapper(const Point *pointArr, size_t pointNum, Point ptInfty);
 
     const Point &getPoint(int idx) const;
     size_t       pointNum() const;
 
+    bool isInfVert(int v) const;
+    bool isInfTri(const Tri &tri) const;
+
+    template <HasInf inf>
+    Orient doOrient2D(int v0, int v1, int v2) const;
+    template <HasInf inf>
+    Orient doOrient2DFastExactSoS(int v0, int v1, int v2) const;
+    template <HasInf inf>
+    Side doIncircle(Tri tri, int vert) const;
+
+    // Runtime dispatch on the presence of the infinity point
     Orient doOrient2D(int v0, int v1, int v2) const;
     Orient doOrient2DFastExactSoS(int v0, int v1, int v2) const;
     Side   doIncircle(Tri tri, int vert) const;
 };
 
+template <>
+Orient PredWrapper::doOrient2D<HasInf::No>(int v0, int v1, int v2) const;
+template <>
+Orient PredWrapper::doOrient2D<HasInf::Yes>(int v0, int v1, int v2) const;
+template <>
+Orient PredWrapper::doOrient2DFastExactSoS<HasInf::No>(int v0, int v1, int v2) const;
+template <>
+Orient PredWrapper::doOrient2DFastExactSoS<HasInf::Yes>(int v0, int v1, int v2) const;
+template <>
+Side PredWrapper::doIncircle<HasInf::No>(Tri tri, int vert) const;
+template <>
+Side PredWrapper::doIncircle<HasInf::Yes>(Tri tri, int vert) const;
+
+}
 #endif //GDEL2D_PREPWRAPPER_H
-}
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cfloat>
+#include <cmath>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -90,14 +91,17 @@ INLINE_H_D void setTriIdxVi(int &output, int oldVi, int ni, int newVi)
     output += ((ni << 2) + newVi) << (oldVi * 4);
 }
 
+// Coordinates closer than this are equal
+constexpr double PointEqualTolerance = 1e-9;
+
 INLINE_H_D bool almost_zero(double x)
 {
-    return std::abs(x) < 1e-9;
+    return std::abs(x) < PointEqualTolerance;
 }
 
 INLINE_H_D bool almost_equal(double x, double y)
 {
-    return std::abs(x - y) < 1e-9;
+    return std::abs(x - y) < PointEqualTolerance;
 }
 
 struct Point
@@ -543,6 +547,143 @@ struct Statistics
     }
 };
 
+// Stage times of Statistics, in report order
+struct StatisticsStage
+{
+    const char *name;
+    double Statistics::*time;
+};
+
+constexpr int StatisticsStageNum = 8;
+
+inline const StatisticsStage *statisticsStages()
+{
+    static const StatisticsStage stages[StatisticsStageNum] = {{"TotalTime", &Statistics::totalTime},
+                                                               {"InitTime", &Statistics::initTime},
+                                                               {"SplitTime", &Statistics::splitTime},
+                                                               {"FlipTime", &Statistics::flipTime},
+                                                               {"RelocateTime", &Statistics::relocateTime},
+                                                               {"SortTime", &Statistics::sortTime},
+                                                               {"ConstraintTime", &Statistics::constraintTime},
+                                                               {"OutTime", &Statistics::outTime}};
+    return stages;
+}
+
+// Spread of each stage time over the timed runs
+struct StatisticsSummary
+{
+    Statistics mean;
+    Statistics min;
+    Statistics max;
+    Statistics stddev; // Sample standard deviation, 0 for a single run
+    Statistics p50;
+    Statistics p95;
+    Statistics p99;
+};
+
+struct StatisticsSummaryField
+{
+    const char *name;
+    Statistics StatisticsSummary::*value;
+};
+
+constexpr int StatisticsSummaryFieldNum = 7;
+
+inline const StatisticsSummaryField *statisticsSummaryFields()
+{
+    static const StatisticsSummaryField fields[StatisticsSummaryFieldNum] = {{"Mean", &StatisticsSummary::mean},
+                                                                             {"Min", &StatisticsSummary::min},
+                                                                             {"Max", &StatisticsSummary::max},
+                                                                             {"StdDev", &StatisticsSummary::stddev},
+                                                                             {"P50", &StatisticsSummary::p50},
+                                                                             {"P95", &StatisticsSummary::p95},
+                                                                             {"P99", &StatisticsSummary::p99}};
+    return fields;
+}
+
+// Statistics of every run. The first warmupNum runs are kept out of the
+// samples and summaries, so a slow first run does not skew them.
+class StatisticsHistory
+{
+  private:
+    std::vector<Statistics> runs;
+    int                     warmupNum = 0;
+
+    // Linear interpolation between the closest ranks of sorted times
+    static double percentile(const std::vector<double> &sorted, double pct)
+    {
+        const double rank = pct / 100 * (sorted.size() - 1);
+        const size_t lo   = static_cast<size_t>(rank);
+        const size_t hi   = std::min(lo + 1, sorted.size() - 1);
+        return sorted[lo] + (rank - lo) * (sorted[hi] - sorted[lo]);
+    }
+
+  public:
+    explicit StatisticsHistory(int warmupNum = 0) : warmupNum(std::max(0, warmupNum)) {}
+
+    void add(const Statistics &s)
+    {
+        runs.push_back(s);
+    }
+
+    void clear()
+    {
+        runs.clear();
+    }
+
+    int warmupRunNum() const
+    {
+        return std::min(warmupNum, static_cast<int>(runs.size()));
+    }
+
+    // Timed runs, without the warm-up ones
+    int runNum() const
+    {
+        return static_cast<int>(runs.size()) - warmupRunNum();
+    }
+
+    std::vector<double> samples(double Statistics::*time) const
+    {
+        std::vector<double> times;
+        times.reserve(runNum());
+        for (size_t i = warmupRunNum(); i < runs.size(); ++i)
+            times.push_back(runs[i].*time);
+        return times;
+    }
+
+    StatisticsSummary summarize() const
+    {
+        StatisticsSummary summary;
+        if (runNum() == 0)
+            return summary;
+
+        for (int s = 0; s < StatisticsStageNum; ++s)
+        {
+            const auto          time  = statisticsStages()[s].time;
+            std::vector<double> times = samples(time);
+            std::sort(times.begin(), times.end());
+
+            double sum = .0;
+            for (const double t : times)
+                sum += t;
+            const double mean = sum / times.size();
+
+            double sqSum = .0;
+            for (const double t : times)
+                sqSum += (t - mean) * (t - mean);
+
+            summary.mean.*time   = mean;
+            summary.min.*time    = times.front();
+            summary.max.*time    = times.back();
+            summary.stddev.*time = times.size() > 1 ? std::sqrt(sqSum / (times.size() - 1)) : .0;
+            summary.p50.*time    = percentile(times, 50);
+            summary.p95.*time    = percentile(times, 95);
+            summary.p99.*time    = percentile(times, 99);
+        }
+        return summary;
+    }
+};
+
 constexpr int TimeLogSize = 6;
 
 class Diagnostic
@@ -0,0 +1,36 @@
+#ifndef DELAUNAY_GENERATOR_COMPACTMESH_H
+#define DELAUNAY_GENERATOR_COMPACTMESH_H
+
+#include "IOType.h"
+
+namespace gdg
+{
+struct CompactMeshOption
+{
+    // Grid step positions are rounded to; the encoding is lossless for
+    // coordinates that lie on this grid
+    double step = 1e-3;
+};
+
+// Compressed mesh archive (.gdc). Boundary loops are closed with one cap
+// vertex each, then triangles are visited in an Edgebreaker-style spiral
+// over the adjacency and each one is coded as C (new vertex), L/R (tip next
+// to the gate), E (loop closed) or S (loop split, with an explicit tip
+// reference). New vertices are stored as quantized parallelogram-prediction
+// residuals. Points and triangles are renumbered in traversal order; points
+// in no triangle are kept after the others.
+// Only meshes whose components are manifold and of genus 0 once capped,
+// such as a Delaunay triangulation, can be written.
+void writeCompactMesh(std::ostream            &out,
+                      const Input             &input,
+                      const Output            &output,
+                      const CompactMeshOption &option = CompactMeshOption());
+
+bool isCompactMesh(const std::string &filename);
+
+// Decode an archive into the point, constraint, triangle and adjacency
+// vectors, with the constraint bits set. Throws std::runtime_error on a
+// truncated or corrupted archive
+void readCompactMesh(const std::string &filename, Input &input, Output &output);
+}
+#endif //DELAUNAY_GENERATOR_COMPACTMESH_H
@@ -6,6 +6,27 @@
 
 namespace gdg
 {
+struct SampleCheckOption
+{
+    double   confidence        = 0.99; // Chance of catching a failure rate of at least tolerance
+    double   tolerance         = 1e-5; // Smallest failure rate that must be caught
+    int      strataNum         = 64;   // Samples are spread evenly over this many triangle / constraint index ranges
+    int      neighbourhoodSize = 4096; // Triangles fully checked around each failing face
+    unsigned seed              = 76213898;
+};
+
+struct SampleCheckResult
+{
+    size_t sampleNum        = 0;
+    size_t failNum          = 0;
+    size_t escalatedNum     = 0; // Triangles checked in the neighbourhoods of failures
+    size_t escalatedFailNum = 0;
+    size_t conSampleNum     = 0;
+    size_t conFailNum       = 0;
+    double failRate         = 0; // Estimated fraction of failing triangles
+    double failRateBound    = 0; // Upper bound of the failure rate at the confidence level, if no failure found
+};
+
 class DelaunayChecker
 {
   private:
@@ -16,16 +37,25 @@ class DelaunayChecker
 
     size_t getVertexCount() const;
     size_t getSegmentCount() const;
-    size_t getTriangleCount();
+    size_t getTriangleCount() const;
+
+    bool isTriFailing(int ti) const;
+    void checkNeighbourhood(int startTi, int maxNum, std::vector<char> &visited, SampleCheckResult &result) const;
 
   public:
     DelaunayChecker() = delete;
     DelaunayChecker(const Input &inputRef, Output &outputRef);
-    void checkEuler();
+    void checkEuler() const;
     void checkAdjacency() const;
     void checkOrientation();
     void checkDelaunay();
     void checkConstraints();
+
+    // Check a random sample of faces and constraints, stratified over index
+    // ranges. Predicates only run on the sample, but finding the sampled
+    // constraint edges takes one pass over all triangles.
+    // Throws std::invalid_argument unless confidence and tolerance are in (0, 1).
+    SampleCheckResult checkSampled(const SampleCheckOption &option) const;
 };
 }
 #endif //DELAUNAY_GENERATOR_DELAUNAYCHECKER_H
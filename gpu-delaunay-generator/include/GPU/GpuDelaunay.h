@@ -47,6 +47,9 @@ class GpuDel
     int  insertTriNum = 0;
 
     MemoryPool memPool;
+    int        poolTriMaxNum = 0; // Triangle capacity of the pool buffers, 0 when freed
+    bool       poolHasCons   = false;
+    bool       keepBuffers   = false;
     FlipDVec   flipVec;
     Int2DVec   triMsgVec;
     IntDVec    actTriVec;
@@ -136,6 +139,11 @@ class GpuDel
 
     void compute(const Input &input, Output &output);
 
+    // Keep the device buffers between compute() calls, so a series of inputs
+    // of similar size reuses them instead of reallocating every time
+    void setKeepBuffers(bool keep);
+    void releaseBuffers();
+
     const Statistics &getStatistics() const;
 };
 
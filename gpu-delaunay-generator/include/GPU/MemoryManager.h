@@ -201,6 +201,12 @@ class DevVector
         resize(inArr.size());
         thrust::copy(inArr.begin(), inArr.end(), begin());
     }
+
+    void copyFromHost(const T *inArr, size_t num)
+    {
+        resize(num);
+        thrust::copy(inArr, inArr + num, begin());
+    }
 };
 
 //////////////////////////////////////////////////////////// Memory pool //
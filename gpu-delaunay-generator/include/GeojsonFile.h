@@ -0,0 +1,25 @@
+#ifndef DELAUNAY_GENERATOR_GEOJSONFILE_H
+#define DELAUNAY_GENERATOR_GEOJSONFILE_H
+
+#include "CommonTypes.h"
+
+namespace gdg
+{
+struct GeojsonOption
+{
+    std::string name = "triangulation";
+    // Written as a named CRS; left out of the file if empty
+    std::string crs = "urn:ogc:def:crs:EPSG::32601";
+};
+
+// Write each triangle as a Polygon feature of a FeatureCollection, with its
+// vertex indices as properties v0, v1 and v2. Features are formatted in
+// parallel batches straight into the stream. Throws std::invalid_argument
+// before writing anything if a vertex has nan or infinite coordinates.
+void writeGeojson(std::ostream        &out,
+                  const Point         *pointArr,
+                  const Tri           *triArr,
+                  size_t               triNum,
+                  const GeojsonOption &option = GeojsonOption());
+}
+#endif //DELAUNAY_GENERATOR_GEOJSONFILE_H
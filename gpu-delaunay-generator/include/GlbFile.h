@@ -0,0 +1,28 @@
+#ifndef DELAUNAY_GENERATOR_GLBFILE_H
+#define DELAUNAY_GENERATOR_GLBFILE_H
+
+#include "CommonTypes.h"
+
+namespace gdg
+{
+struct GlbOption
+{
+    // Store positions as uint16 steps across the bounding box
+    // (KHR_mesh_quantization) instead of float32
+    bool quantize = false;
+};
+
+// Write points and triangles as a binary glTF 2.0 (.glb) mesh. Positions are
+// stored relative to the bounding box minimum, which goes into the node
+// transform together with the scale when quantizing. Indices use the
+// narrowest of uint8, uint16 and uint32 that fits the vertex count. Throws
+// std::invalid_argument if there are no points or no triangles, which glTF
+// cannot represent.
+void writeGlb(std::ostream    &out,
+              const Point     *pointArr,
+              size_t           pointNum,
+              const Tri       *triArr,
+              size_t           triNum,
+              const GlbOption &option = GlbOption());
+}
+#endif //DELAUNAY_GENERATOR_GLBFILE_H
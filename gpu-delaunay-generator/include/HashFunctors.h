@@ -5,14 +5,17 @@
 
 namespace gdg
 {
+// Hashes x and y like Point::operator==, combined so swapped coordinates
+// differ. Points equal only within the tolerance may still hash apart; see
+// Input::removeDuplicates() for tolerance-aware deduplication.
 struct PointHash
 {
     std::size_t operator()(const Point &p) const
     {
-        auto h1 = std::hash<double>{}(p._p[0]);
-        auto h2 = std::hash<double>{}(p._p[1]);
-        auto h3 = std::hash<double>{}(p._p[2]);
-        return h1 ^ h2 ^ h3;
+        // +0.0 folds -0 into +0
+        auto h1 = std::hash<double>{}(p._p[0] + 0.0);
+        auto h2 = std::hash<double>{}(p._p[1] + 0.0);
+        return h1 ^ (h2 + 0x9e3779b97f4a7c15ULL + (h1 << 6) + (h1 >> 2));
     }
 };
 
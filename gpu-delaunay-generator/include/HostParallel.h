@@ -0,0 +1,85 @@
+#ifndef DELAUNAY_GENERATOR_HOSTPARALLEL_H
+#define DELAUNAY_GENERATOR_HOSTPARALLEL_H
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace gdg
+{
+// Ranges smaller than this are not worth a thread of their own
+constexpr int MinItemsPerThread = 4096;
+
+inline int hostThreadNum()
+{
+    const unsigned int num = std::thread::hardware_concurrency();
+    return (num == 0) ? 1 : static_cast<int>(num);
+}
+
+// Number of threads parallelFor() will use for a range of num items
+inline int parallelThreadNum(long long num)
+{
+    const long long byWork = std::max(1LL, num / MinItemsPerThread);
+    return static_cast<int>(std::min<long long>(hostThreadNum(), byWork));
+}
+
+// Split [0, num) into one contiguous range per thread and call
+// func(threadIdx, begin, end) on each. The calling thread takes the first range.
+template <typename Index, typename Func>
+void parallelFor(Index num, Func func)
+{
+    const int threadNum = parallelThreadNum(num);
+    if (threadNum <= 1)
+    {
+        if (num > 0)
+            func(0, Index(0), num);
+        return;
+    }
+
+    const Index chunk = (num + threadNum - 1) / threadNum;
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadNum - 1);
+    for (int t = 1; t < threadNum; ++t)
+    {
+        const Index begin = std::min<Index>(num, chunk * t);
+        const Index end   = std::min<Index>(num, begin + chunk);
+        threads.emplace_back(func, t, begin, end);
+    }
+    func(0, Index(0), std::min<Index>(num, chunk));
+
+    for (auto &thread : threads)
+        thread.join();
+}
+
+// Call func(threadIdx) for every threadIdx in [0, threadNum), each on a
+// thread of its own. The calling thread takes index 0.
+template <typename Func>
+void parallelInvoke(int threadNum, Func func)
+{
+    std::vector<std::thread> threads;
+    threads.reserve(std::max(0, threadNum - 1));
+    for (int t = 1; t < threadNum; ++t)
+        threads.emplace_back(func, t);
+    if (threadNum > 0)
+        func(0);
+
+    for (auto &thread : threads)
+        thread.join();
+}
+
+// Sum of func(begin, end) over the per-thread ranges of [0, num)
+template <typename T, typename Index, typename Func>
+T parallelSum(Index num, Func func)
+{
+    std::vector<T> partial(parallelThreadNum(num), T());
+
+    parallelFor(num, [&](int t, Index begin, Index end) { partial[t] = func(begin, end); });
+
+    T sum = T();
+    for (const T &val : partial)
+        sum += val;
+    return sum;
+}
+}
+#endif //DELAUNAY_GENERATOR_HOSTPARALLEL_H
@@ -2,9 +2,16 @@
 #define DELAUNAY_GENERATOR_IOTYPE_H
 
 #include "CommonTypes.h"
+#include "MappedFile.h"
+#include <memory>
 
 namespace gdg
 {
+struct Input;
+struct Output;
+
+// Defined in MeshSnapshot.cpp, maps both the input and the output arrays
+void loadMeshSnapshot(const std::string &filename, Input &input, Output &output);
 
 struct Input
 {
@@ -17,7 +24,34 @@ struct Input
 
     Input() = default;
 
-    void removeDuplicates();
+    // Points and constraints, either held in the vectors above or used in
+    // place from a mapped binary point file
+    const Point *points() const;
+    size_t       pointNum() const;
+    const Edge  *constraints() const;
+    size_t       constraintNum() const;
+
+    bool isMapped() const;
+
+    // Use a binary point file (see PointFile.h) without copying it. Without
+    // withConstraints only the points are mapped and constraintVec is kept.
+    void mapFromFile(const std::string &filename, bool withConstraints = true);
+    // Copy mapped points and constraints into the vectors and drop the mapping
+    void unmap();
+
+    // Remove points equal (Point::operator==) to an earlier kept point, in
+    // parallel on a grid of the equality tolerance, and remap the constraints
+    // onto the kept points. Returns the number removed.
+    size_t removeDuplicates();
+
+  private:
+    friend void loadMeshSnapshot(const std::string &filename, Input &input, Output &output);
+
+    std::shared_ptr<const MappedFile> mappedFile;
+    const Point                      *mappedPointArr      = nullptr;
+    size_t                            mappedPointNum      = 0;
+    const Edge                       *mappedConstraintArr = nullptr;
+    size_t                            mappedConstraintNum = 0;
 };
 
 struct Output
@@ -27,9 +61,28 @@ struct Output
     std::set<Edge> edgeSet;
     Point          infPt;
 
+    // Triangles and their adjacency, either held in the vectors above or
+    // used in place from a mapped mesh snapshot
+    const Tri    *tris() const;
+    const TriOpp *triOpps() const;
+    size_t        triNum() const;
+
+    bool isMapped() const;
+    // Copy mapped triangles into the vectors and drop the mapping
+    void unmap();
+
+    // Clear the result, dropping any mapping
     void reset();
 
     void getEdgesFromTriVec();
+
+  private:
+    friend void loadMeshSnapshot(const std::string &filename, Input &input, Output &output);
+
+    std::shared_ptr<const MappedFile> mappedFile;
+    const Tri                        *mappedTriArr    = nullptr;
+    const TriOpp                     *mappedTriOppArr = nullptr;
+    size_t                            mappedTriNum    = 0;
 };
 }
 #endif //DELAUNAY_GENERATOR_IOTYPE_H
\ No newline at end of file
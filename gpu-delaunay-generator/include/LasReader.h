@@ -0,0 +1,85 @@
+#ifndef DELAUNAY_GENERATOR_LASREADER_H
+#define DELAUNAY_GENERATOR_LASREADER_H
+
+#include "CommonTypes.h"
+#include "MappedFile.h"
+#include <bitset>
+#include <cstdint>
+#include <future>
+
+namespace gdg
+{
+// Fields of the LAS 1.0-1.4 public header block needed to decode the points
+struct LasHeader
+{
+    int      versionMajor = 0;
+    int      versionMinor = 0;
+    int      pointFormat  = 0;
+    int      recordLength = 0;
+    uint64_t pointNum     = 0;
+    uint64_t pointOffset  = 0;
+    double   scale[3]     = {1, 1, 1};
+    double   offset[3]    = {0, 0, 0};
+    double   minVal[3]    = {0, 0, 0};
+    double   maxVal[3]    = {0, 0, 0};
+};
+
+// Points are kept if their classification and return number are both
+// accepted; empty sets accept everything
+struct LasFilter
+{
+    std::vector<int> classifications;
+    std::vector<int> returnNumbers;
+    bool             lastReturnOnly = false;
+};
+
+// Reader of uncompressed LAS files with point data record formats 0-10
+class LasReader
+{
+  private:
+    MappedFile       file;
+    LasHeader        _header;
+    std::bitset<256> classMask;
+    std::bitset<16>  returnMask;
+    bool             lastReturnOnly = false;
+
+    void readHeader();
+
+  public:
+    static constexpr size_t DefaultChunkSize = 1 << 20;
+
+    LasReader() = delete;
+    explicit LasReader(const std::string &filename, const LasFilter &filter = LasFilter());
+
+    const LasHeader &header() const;
+
+    // Decode records from first on until chunkSize points pass the filter or
+    // the records run out. Returns the index of the first record not read.
+    uint64_t readChunk(uint64_t first, size_t chunkSize, Point2DHVec &chunk) const;
+
+    // Call func(const Point2DHVec &chunk) on consecutive chunks of filtered
+    // points. The next chunk is decoded while func runs on the current one.
+    template <typename Func>
+    void forEachChunk(size_t chunkSize, Func func) const;
+
+    void read(Point2DHVec &pointVec, size_t chunkSize = DefaultChunkSize) const;
+};
+
+template <typename Func>
+void LasReader::forEachChunk(size_t chunkSize, Func func) const
+{
+    Point2DHVec current;
+    Point2DHVec next;
+
+    uint64_t record = readChunk(0, chunkSize, current);
+    while (!current.empty())
+    {
+        auto decoding = std::async(std::launch::async,
+                                   [this, record, chunkSize, &next] { return readChunk(record, chunkSize, next); });
+        func(static_cast<const Point2DHVec &>(current));
+        record = decoding.get();
+        current.swap(next);
+    }
+}
+}
+#endif //DELAUNAY_GENERATOR_LASREADER_H
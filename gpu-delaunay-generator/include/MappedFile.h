@@ -0,0 +1,28 @@
+#ifndef DELAUNAY_GENERATOR_MAPPEDFILE_H
+#define DELAUNAY_GENERATOR_MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace gdg
+{
+// Read-only memory mapping of a whole file
+class MappedFile
+{
+  private:
+    const char *_data = nullptr;
+    size_t      _size = 0;
+
+  public:
+    MappedFile() = delete;
+    explicit MappedFile(const std::string &filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &)            = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const char *data() const;
+    size_t      size() const;
+};
+}
+#endif //DELAUNAY_GENERATOR_MAPPEDFILE_H
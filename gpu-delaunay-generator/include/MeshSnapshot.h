@@ -0,0 +1,42 @@
+#ifndef DELAUNAY_GENERATOR_MESHSNAPSHOT_H
+#define DELAUNAY_GENERATOR_MESHSNAPSHOT_H
+
+#include "IOType.h"
+#include <cstdint>
+
+namespace gdg
+{
+// Binary snapshot of a triangulated mesh (.gdm), little-endian:
+//   MeshSnapshotHeader
+//   Point[pointNum]       at pointOffset
+//   Edge[constraintNum]   at constraintOffset
+//   Tri[triNum]           at triOffset
+//   TriOpp[triNum]        at triOppOffset, with the constraint bits
+// Arrays are aligned to MeshSnapshotAlign bytes so that loadMeshSnapshot()
+// can point Input and Output straight into a memory mapping.
+constexpr char     MeshSnapshotMagic[4] = {'G', 'D', 'G', 'M'};
+constexpr uint32_t MeshSnapshotVersion  = 1;
+constexpr uint64_t MeshSnapshotAlign    = 64;
+
+struct MeshSnapshotHeader
+{
+    char     magic[4];
+    uint32_t version;
+    uint64_t pointNum;
+    uint64_t constraintNum;
+    uint64_t triNum;
+    uint64_t pointOffset;
+    uint64_t constraintOffset;
+    uint64_t triOffset;
+    uint64_t triOppOffset;
+    Point    infPt;
+};
+
+bool isMeshSnapshot(const std::string &filename);
+
+void saveMeshSnapshot(const std::string &filename, const Input &input, const Output &output);
+
+// Validate the header of a mapped snapshot; throws if it is malformed
+const MeshSnapshotHeader &checkMeshSnapshotHeader(const char *data, size_t size);
+}
+#endif //DELAUNAY_GENERATOR_MESHSNAPSHOT_H
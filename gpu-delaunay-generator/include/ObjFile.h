@@ -0,0 +1,18 @@
+#ifndef DELAUNAY_GENERATOR_OBJFILE_H
+#define DELAUNAY_GENERATOR_OBJFILE_H
+
+#include "CommonTypes.h"
+
+namespace gdg
+{
+// Write points and triangles as Wavefront OBJ. Coordinates are printed with
+// the shortest round-trip representation. With withColor every vertex gets
+// an RGB colour cycling through a small palette.
+void writeObj(std::ostream &out,
+              const Point  *pointArr,
+              size_t        pointNum,
+              const Tri    *triArr,
+              size_t        triNum,
+              bool          withColor = false);
+}
+#endif //DELAUNAY_GENERATOR_OBJFILE_H
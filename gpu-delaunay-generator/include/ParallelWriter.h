@@ -0,0 +1,71 @@
+#ifndef DELAUNAY_GENERATOR_PARALLELWRITER_H
+#define DELAUNAY_GENERATOR_PARALLELWRITER_H
+
+#include "HostParallel.h"
+#include <charconv>
+#include <ostream>
+#include <stdexcept>
+
+namespace gdg
+{
+// Records formatted per batch; bounds the buffer memory to about
+// WriterBatchSize * maxRecordSize bytes
+constexpr size_t WriterBatchSize = 1 << 18;
+
+// Longest output of writeDouble()/writeInt()
+constexpr size_t MaxDoubleChars = 24;
+constexpr size_t MaxIntChars    = 20;
+
+inline char *writeDouble(char *ptr, double val)
+{
+    return std::to_chars(ptr, ptr + MaxDoubleChars, val).ptr;
+}
+
+inline char *writeInt(char *ptr, long long val)
+{
+    return std::to_chars(ptr, ptr + MaxIntChars, val).ptr;
+}
+
+inline char *writeStr(char *ptr, const char *str)
+{
+    while (*str != '\0')
+        *ptr++ = *str++;
+    return ptr;
+}
+
+// Write records [0, num) in order. format(i, ptr) prints record i starting at
+// ptr, using at most maxRecordSize chars, and returns the end of the output.
+// Each batch is formatted by several threads into their own buffers, which
+// are then written one after another.
+template <typename Func>
+void writeParallel(std::ostream &out, size_t num, size_t maxRecordSize, Func format)
+{
+    std::vector<std::vector<char>> buffers(hostThreadNum());
+    std::vector<size_t>            lengths(buffers.size());
+
+    for (size_t first = 0; first < num; first += WriterBatchSize)
+    {
+        const size_t batchNum  = std::min(WriterBatchSize, num - first);
+        const int    threadNum = parallelThreadNum(batchNum);
+
+        parallelFor(batchNum, [&](int t, size_t begin, size_t end) {
+            std::vector<char> &buffer = buffers[t];
+            buffer.resize((end - begin) * maxRecordSize);
+
+            char *ptr = buffer.data();
+            for (size_t i = first + begin; i < first + end; ++i)
+                ptr = format(i, ptr);
+            lengths[t] = ptr - buffer.data();
+        });
+
+        for (int t = 0; t < threadNum; ++t)
+            out.write(buffers[t].data(), static_cast<std::streamsize>(lengths[t]));
+    }
+
+    if (!out)
+    {
+        throw std::runtime_error("ParallelWriter: failed writing output");
+    }
+}
+}
+#endif //DELAUNAY_GENERATOR_PARALLELWRITER_H
@@ -0,0 +1,17 @@
+#ifndef DELAUNAY_GENERATOR_PLYFILE_H
+#define DELAUNAY_GENERATOR_PLYFILE_H
+
+#include "CommonTypes.h"
+
+namespace gdg
+{
+// Write points and triangles as binary little-endian PLY. Vertices are
+// written straight from pointArr as doubles, faces as uchar/int lists.
+void writePly(std::ostream &out, const Point *pointArr, size_t pointNum, const Tri *triArr, size_t triNum);
+
+// Append the vertices of a binary little-endian PLY file to pointVec. The
+// x, y and z properties may be of any scalar type; other properties and
+// elements are skipped.
+void readPlyPoints(const std::string &filename, Point2DHVec &pointVec);
+}
+#endif //DELAUNAY_GENERATOR_PLYFILE_H
@@ -0,0 +1,44 @@
+#ifndef DELAUNAY_GENERATOR_POINTFILE_H
+#define DELAUNAY_GENERATOR_POINTFILE_H
+
+#include "CommonTypes.h"
+#include <cstdint>
+
+namespace gdg
+{
+// Binary point/constraint container (.gdp), little-endian:
+//   PointFileHeader
+//   Point[pointNum] at pointOffset
+//   Edge[constraintNum] at constraintOffset
+// Both arrays are aligned to PointFileAlign bytes so they can be used in
+// place from a memory mapping.
+constexpr char     PointFileMagic[4] = {'G', 'D', 'G', 'P'};
+constexpr uint32_t PointFileVersion  = 1;
+constexpr uint64_t PointFileAlign    = 64;
+
+struct PointFileHeader
+{
+    char     magic[4];
+    uint32_t version;
+    uint64_t pointNum;
+    uint64_t constraintNum;
+    uint64_t pointOffset;
+    uint64_t constraintOffset;
+    double   minVal[3];
+    double   maxVal[3];
+    uint32_t flags; // None defined yet, written as zero
+    uint32_t reserved;
+};
+
+bool isPointFile(const std::string &filename);
+
+void writePointFile(const std::string &filename,
+                    const Point       *pointArr,
+                    size_t             pointNum,
+                    const Edge        *constraintArr,
+                    size_t             constraintNum);
+
+// Validate the header of a mapped point file; throws if it is malformed
+const PointFileHeader &checkPointFileHeader(const char *data, size_t size);
+}
+#endif //DELAUNAY_GENERATOR_POINTFILE_H
@@ -0,0 +1,70 @@
+#ifndef DELAUNAY_GENERATOR_RESULTCACHE_H
+#define DELAUNAY_GENERATOR_RESULTCACHE_H
+
+#include "IOType.h"
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+namespace gdg
+{
+struct ResultCacheKey
+{
+    uint64_t hash[2];
+    uint64_t pointNum;
+    uint64_t constraintNum;
+
+    // File name of the cache entry
+    std::string name() const;
+};
+
+// 128-bit content hash of the points, the constraints, the input flags
+// that change the triangulation and the revision the library was built
+// from. Hashed in parallel, the same for any thread count.
+ResultCacheKey makeResultCacheKey(const Input &input);
+
+struct ResultCacheStats
+{
+    size_t hitNum   = 0;
+    size_t missNum  = 0;
+    size_t evictNum = 0;
+};
+
+// On-disk cache of triangulations, one file per input in a directory holding
+// the triangles and their adjacency. When the entries exceed the capacity in
+// bytes the least recently used are evicted; the use order is kept in the
+// file modification times, so it carries over to later runs. Not thread-safe.
+class ResultCache
+{
+  private:
+    struct Entry
+    {
+        std::string name;
+        uint64_t    size;
+    };
+    using EntryIter = std::list<Entry>::iterator;
+
+    std::string                                directory;
+    uint64_t                                   capacity;
+    uint64_t                                   totalSize = 0;
+    std::list<Entry>                           lruList; // Most recently used first
+    std::unordered_map<std::string, EntryIter> entryMap;
+    ResultCacheStats                           cacheStats;
+
+    std::string path(const std::string &name) const;
+    void        touch(EntryIter iter);
+    void        remove(EntryIter iter);
+    void        evict();
+
+  public:
+    ResultCache(const std::string &directory, uint64_t capacity);
+
+    // Fill output with the cached triangulation of key; false on a miss
+    bool load(const ResultCacheKey &key, Output &output);
+    // Add the triangulation of key, evicting old entries to stay in capacity
+    void store(const ResultCacheKey &key, const Output &output);
+
+    const ResultCacheStats &stats() const;
+};
+}
+#endif //DELAUNAY_GENERATOR_RESULTCACHE_H
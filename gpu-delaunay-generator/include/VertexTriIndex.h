@@ -0,0 +1,37 @@
+#ifndef DELAUNAY_GENERATOR_VERTEXTRIINDEX_H
+#define DELAUNAY_GENERATOR_VERTEXTRIINDEX_H
+
+#include "CommonTypes.h"
+
+namespace gdg
+{
+// Vertex star index in CSR layout: the triangles incident to vertex v are
+// entries [offsetVec[v], offsetVec[v + 1]) of triViVec, each packed as
+// (triIdx << 2) | vi with vi the position of v in the triangle. Stars are
+// sorted by triangle index, so the index is the same for any thread count.
+class VertexTriIndex
+{
+  private:
+    IntHVec offsetVec;
+    IntHVec triViVec;
+
+  public:
+    VertexTriIndex() = default;
+    VertexTriIndex(const TriHVec &triVec, size_t vertNum);
+    VertexTriIndex(const Tri *triArr, size_t triNum, size_t vertNum);
+
+    void build(const TriHVec &triVec, size_t vertNum);
+    void build(const Tri *triArr, size_t triNum, size_t vertNum);
+
+    size_t vertNum() const;
+    int    degree(int v) const;
+    int    starTri(int v, int i) const;
+    int    starVi(int v, int i) const;
+
+    // Find a triangle having edge v0-v1 in O(degree). Returns the triangle
+    // index and sets oppVi to the index of the vertex opposite the edge, or
+    // returns -1 if the edge is not in the triangulation.
+    int findEdge(int v0, int v1, int &oppVi) const;
+};
+}
+#endif //DELAUNAY_GENERATOR_VERTEXTRIINDEX_H
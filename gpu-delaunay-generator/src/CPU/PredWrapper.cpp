@@ -7,9 +7,14 @@ PredWrapper::PredWrapper() : _pointArr(nullptr), _pointNum(0), _infIdx(0)
 }
 
 PredWrapper::PredWrapper(const Point2DHVec &pointVec, Point ptInfty)
+    : PredWrapper(pointVec.data(), pointVec.size(), ptInfty)
 {
-    _pointArr = &pointVec[0];
-    _pointNum = pointVec.size();
+}
+
+PredWrapper::PredWrapper(const Point *pointArr, size_t pointNum, Point ptInfty)
+{
+    _pointArr = pointArr;
+    _pointNum = pointNum;
     _infIdx   = _pointNum;
     _ptInfty  = ptInfty;
     exactinit();
@@ -25,7 +30,26 @@ size_t PredWrapper::pointNum() const
     return _pointNum + 1;
 }
 
-Orient PredWrapper::doOrient2D(int v0, int v1, int v2) const
+bool PredWrapper::isInfVert(int v) const
+{
+    return v == static_cast<int>(_infIdx);
+}
+
+bool PredWrapper::isInfTri(const Tri &tri) const
+{
+    return tri.has(static_cast<int>(_infIdx));
+}
+
+template <>
+Orient PredWrapper::doOrient2D<HasInf::No>(int v0, int v1, int v2) const
+{
+    assert((v0 != v1) && (v0 != v2) && (v1 != v2) && "Duplicate indices in orientation!");
+
+    return ortToOrient(orient2d(_pointArr[v0]._p, _pointArr[v1]._p, _pointArr[v2]._p));
+}
+
+template <>
+Orient PredWrapper::doOrient2D<HasInf::Yes>(int v0, int v1, int v2) const
 {
     assert((v0 != v1) && (v0 != v2) && (v1 != v2) && "Duplicate indices in orientation!");
 
@@ -33,12 +57,20 @@ Orient PredWrapper::doOrient2D(int v0, int v1, int v2) const
 
     double det = orient2d(p[0]._p, p[1]._p, p[2]._p);
 
-    if ((v0 == _infIdx) || (v1 == _infIdx) || (v2 == _infIdx))
+    if (isInfVert(v0) || isInfVert(v1) || isInfVert(v2))
         det = -det;
 
     return ortToOrient(det);
 }
 
+Orient PredWrapper::doOrient2D(int v0, int v1, int v2) const
+{
+    if (isInfVert(v0) || isInfVert(v1) || isInfVert(v2))
+        return doOrient2D<HasInf::Yes>(v0, v1, v2);
+
+    return doOrient2D<HasInf::No>(v0, v1, v2);
+}
+
 Orient PredWrapper::doOrient2DSoSOnly(const double *p0, const double *p1, const double *p2, int v0, int v1, int v2)
 {
     ////
@@ -96,37 +128,67 @@ Orient PredWrapper::doOrient2DSoSOnly(const double *p0, const double *p1, const
     return ortToOrient(det);
 }
 
-Orient PredWrapper::doOrient2DFastExactSoS(int v0, int v1, int v2) const
+template <>
+Orient PredWrapper::doOrient2DFastExactSoS<HasInf::No>(int v0, int v1, int v2) const
+{
+    // Fast-Exact
+    Orient ord = doOrient2D<HasInf::No>(v0, v1, v2);
+
+    if (OrientZero == ord)
+        ord = doOrient2DSoSOnly(_pointArr[v0]._p, _pointArr[v1]._p, _pointArr[v2]._p, v0, v1, v2);
+
+    return ord;
+}
+
+template <>
+Orient PredWrapper::doOrient2DFastExactSoS<HasInf::Yes>(int v0, int v1, int v2) const
 {
     const double *pt[] = {getPoint(v0)._p, getPoint(v1)._p, getPoint(v2)._p};
 
     // Fast-Exact
-    Orient ord = doOrient2D(v0, v1, v2);
+    Orient ord = doOrient2D<HasInf::Yes>(v0, v1, v2);
 
     if (OrientZero == ord)
         ord = doOrient2DSoSOnly(pt[0], pt[1], pt[2], v0, v1, v2);
 
-    if (v0 == _infIdx | v1 == _infIdx)
+    if (isInfVert(v0) || isInfVert(v1))
         ord = flipOrient(ord);
 
     return ord;
 }
 
+Orient PredWrapper::doOrient2DFastExactSoS(int v0, int v1, int v2) const
+{
+    if (isInfVert(v0) || isInfVert(v1) || isInfVert(v2))
+        return doOrient2DFastExactSoS<HasInf::Yes>(v0, v1, v2);
+
+    return doOrient2DFastExactSoS<HasInf::No>(v0, v1, v2);
+}
+
 ///////////////////////////////////////////////////////////////////// Circle //
 
-Side PredWrapper::doIncircle(Tri tri, int vert) const
+template <>
+Side PredWrapper::doIncircle<HasInf::No>(Tri tri, int vert) const
+{
+    const double det = incircle(
+        _pointArr[tri._v[0]]._p, _pointArr[tri._v[1]]._p, _pointArr[tri._v[2]]._p, _pointArr[vert]._p);
+
+    return cicToSide(det);
+}
+
+template <>
+Side PredWrapper::doIncircle<HasInf::Yes>(Tri tri, int vert) const
 {
-    if (vert == _infIdx)
+    if (isInfVert(vert))
         return SideOut;
 
     const Point pt[] = {getPoint(tri._v[0]), getPoint(tri._v[1]), getPoint(tri._v[2]), getPoint(vert)};
 
     double det;
 
-    const auto int_infIdx = static_cast<int>(_infIdx);
-    if (tri.has(int_infIdx))
+    if (isInfTri(tri))
     {
-        const int infVi = tri.getIndexOf(int_infIdx);
+        const int infVi = tri.getIndexOf(static_cast<int>(_infIdx));
 
         det = orient2d(pt[(infVi + 1) % 3]._p, pt[(infVi + 2) % 3]._p, pt[3]._p);
     }
@@ -135,4 +197,12 @@ Side PredWrapper::doIncircle(Tri tri, int vert) const
 
     return cicToSide(det);
 }
+
+Side PredWrapper::doIncircle(Tri tri, int vert) const
+{
+    if (isInfVert(vert) || isInfTri(tri))
+        return doIncircle<HasInf::Yes>(tri, vert);
+
+    return doIncircle<HasInf::No>(tri, vert);
+}
 }
\ No newline at end of file
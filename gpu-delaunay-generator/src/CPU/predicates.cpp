@@ -1348,4 +1348,47 @@ double incircle(const double *pa, const double *pb, const double *pc, const doub
 
     return incircleadapt(pa, pb, pc, pd, permanent);
 }
+
+/* Like orient2dzero(), returns 0.0 whenever the floating-point filter of    */
+/*   incircle() cannot certify the sign.                                     */
+
+double incirclezero(const double *pa, const double *pb, const double *pc, const double *pd)
+{
+    double adx, bdx, cdx, ady, bdy, cdy;
+    double bdxcdy, cdxbdy, cdxady, adxcdy, adxbdy, bdxady;
+    double alift, blift, clift;
+    double det;
+    double permanent, errbound;
+
+    adx = pa[0] - pd[0];
+    bdx = pb[0] - pd[0];
+    cdx = pc[0] - pd[0];
+    ady = pa[1] - pd[1];
+    bdy = pb[1] - pd[1];
+    cdy = pc[1] - pd[1];
+
+    bdxcdy = bdx * cdy;
+    cdxbdy = cdx * bdy;
+    alift  = adx * adx + ady * ady;
+
+    cdxady = cdx * ady;
+    adxcdy = adx * cdy;
+    blift  = bdx * bdx + bdy * bdy;
+
+    adxbdy = adx * bdy;
+    bdxady = bdx * ady;
+    clift  = cdx * cdx + cdy * cdy;
+
+    det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady);
+
+    permanent = (Absolute(bdxcdy) + Absolute(cdxbdy)) * alift + (Absolute(cdxady) + Absolute(adxcdy)) * blift +
+                (Absolute(adxbdy) + Absolute(bdxady)) * clift;
+    errbound = iccerrboundA * permanent;
+    if ((det > errbound) || (-det > errbound))
+    {
+        return det;
+    }
+
+    return 0.0;
+}
 }
\ No newline at end of file
@@ -0,0 +1,948 @@
+#include "../include/CompactMesh.h"
+#include "../include/MappedFile.h"
+#include "../include/VertexTriIndex.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace gdg
+{
+namespace
+{
+constexpr char     CompactMeshMagic[4] = {'G', 'D', 'G', 'C'};
+constexpr uint32_t CompactMeshVersion  = 1;
+
+// Header followed by the symbol, vertex, reference and constraint streams
+struct CompactMeshHeader
+{
+    char     magic[4];
+    uint32_t version;
+    uint64_t pointNum;     // All points, including those in no triangle
+    uint64_t usedPointNum; // Points reached by the traversal, numbered first
+    uint64_t triNum;       // Triangles without the caps
+    uint64_t constraintNum;
+    uint64_t componentNum;
+    uint64_t capNum; // Cap vertices closing the boundary loops
+    double   step;
+    double   origin[3];
+    Point    infPt;
+    uint64_t symbolSize; // Byte sizes of the streams
+    uint64_t vertexSize;
+    uint64_t refSize;
+    uint64_t constraintSize;
+};
+
+// Prefix code: C 0, R 10, L 110, E 1110, S 11110, D 11111 (new cap vertex)
+enum Symbol
+{
+    SymbolC,
+    SymbolR,
+    SymbolL,
+    SymbolE,
+    SymbolS,
+    SymbolD
+};
+
+inline int nextCorner(int c)
+{
+    return (c % 3 == 2) ? c - 2 : c + 1;
+}
+
+inline int prevCorner(int c)
+{
+    return (c % 3 == 0) ? c + 2 : c - 1;
+}
+
+class BitWriter
+{
+  private:
+    std::vector<uint8_t> bytes;
+    int                  bitPos = 8;
+
+  public:
+    void writeSymbol(Symbol symbol)
+    {
+        const int oneNum = static_cast<int>(symbol);
+        for (int i = 0; i < oneNum; ++i)
+            writeBit(1);
+        if (oneNum < SymbolD)
+            writeBit(0);
+    }
+
+    void writeBit(int bit)
+    {
+        if (bitPos == 8)
+        {
+            bytes.push_back(0);
+            bitPos = 0;
+        }
+        bytes.back() |= bit << (7 - bitPos++);
+    }
+
+    const std::vector<uint8_t> &data() const
+    {
+        return bytes;
+    }
+};
+
+class BitReader
+{
+  private:
+    const uint8_t *ptr;
+    const uint8_t *end;
+    int            bitPos = 0;
+
+  public:
+    BitReader(const uint8_t *begin, size_t size) : ptr(begin), end(begin + size) {}
+
+    int readBit()
+    {
+        if (ptr == end)
+        {
+            throw std::runtime_error("CompactMesh: symbol stream ended early");
+        }
+        const int bit = (*ptr >> (7 - bitPos)) & 1;
+        if (++bitPos == 8)
+        {
+            bitPos = 0;
+            ++ptr;
+        }
+        return bit;
+    }
+
+    Symbol readSymbol()
+    {
+        int oneNum = 0;
+        while (oneNum < SymbolD && readBit() == 1)
+            ++oneNum;
+        return static_cast<Symbol>(oneNum);
+    }
+};
+
+void writeVarint(std::vector<uint8_t> &stream, uint64_t val)
+{
+    while (val >= 0x80)
+    {
+        stream.push_back(static_cast<uint8_t>(val | 0x80));
+        val >>= 7;
+    }
+    stream.push_back(static_cast<uint8_t>(val));
+}
+
+void writeSigned(std::vector<uint8_t> &stream, int64_t val)
+{
+    writeVarint(stream, (static_cast<uint64_t>(val) << 1) ^ static_cast<uint64_t>(val >> 63));
+}
+
+class ByteReader
+{
+  private:
+    const uint8_t *ptr;
+    const uint8_t *end;
+
+  public:
+    ByteReader(const uint8_t *begin, size_t size) : ptr(begin), end(begin + size) {}
+
+    uint64_t readVarint()
+    {
+        uint64_t val = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            if (ptr == end)
+            {
+                throw std::runtime_error("CompactMesh: stream ended early");
+            }
+            const uint8_t byte = *ptr++;
+            val |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                return val;
+        }
+        throw std::runtime_error("CompactMesh: malformed varint");
+    }
+
+    int64_t readSigned()
+    {
+        const uint64_t val = readVarint();
+        return static_cast<int64_t>(val >> 1) ^ -static_cast<int64_t>(val & 1);
+    }
+};
+
+// Quantized positions, with the parallelogram prediction used for new
+// vertices. Only points below realNum have a position.
+struct QuantizedPoints
+{
+    std::vector<int64_t> coor;
+    size_t               realNum;
+
+    int64_t *at(int v)
+    {
+        return &coor[3 * static_cast<size_t>(v)];
+    }
+
+    // Predict the tip of a triangle across gate u-v from the triangle u-v-w
+    void predict(int u, int v, int w, int last, int64_t pred[3])
+    {
+        const bool uReal = u < (int)realNum, vReal = v < (int)realNum, wReal = w < (int)realNum;
+        for (int j = 0; j < 3; ++j)
+        {
+            if (uReal && vReal && wReal)
+                pred[j] = at(u)[j] + at(v)[j] - at(w)[j];
+            else if (uReal)
+                pred[j] = at(u)[j];
+            else if (vReal)
+                pred[j] = at(v)[j];
+            else
+                pred[j] = (last >= 0) ? at(last)[j] : 0;
+        }
+    }
+};
+
+// Boundary loops between the coded and the remaining triangles, as cyclic
+// lists of nodes. The edge from a node to the next one belongs to a coded
+// triangle, whose corner opposite the edge is kept in corner. Encoder and
+// decoder run the same operations so their node numbering agrees.
+class ActiveLoops
+{
+  public:
+    std::vector<int> vert;
+    std::vector<int> next;
+    std::vector<int> prev;
+    std::vector<int> corner;
+
+  private:
+    std::vector<int>  sameNext; // Next active node of the same vertex, in creation order
+    std::vector<int>  vertHead;
+    std::vector<char> alive;
+
+  public:
+    explicit ActiveLoops(size_t vertNum) : vertHead(vertNum, -1) {}
+
+    int addNode(int v, int c)
+    {
+        const int node = (int)vert.size();
+        vert.push_back(v);
+        next.push_back(-1);
+        prev.push_back(-1);
+        corner.push_back(c);
+        sameNext.push_back(-1);
+        alive.push_back(1);
+
+        if (vertHead[v] < 0)
+        {
+            vertHead[v] = node;
+        }
+        else
+        {
+            int n = vertHead[v];
+            while (sameNext[n] >= 0)
+                n = sameNext[n];
+            sameNext[n] = node;
+        }
+        return node;
+    }
+
+    void removeNode(int node)
+    {
+        if (!alive[node])
+        {
+            throw std::runtime_error("CompactMesh: boundary loop is corrupted");
+        }
+        alive[node] = 0;
+
+        int &head = vertHead[vert[node]];
+        if (head == node)
+        {
+            head = sameNext[node];
+            return;
+        }
+        int n = head;
+        while (n >= 0 && sameNext[n] != node)
+            n = sameNext[n];
+        if (n < 0)
+        {
+            throw std::runtime_error("CompactMesh: boundary loop is corrupted");
+        }
+        sameNext[n] = sameNext[node];
+    }
+
+    bool isAlive(int node) const
+    {
+        return node >= 0 && node < (int)alive.size() && alive[node];
+    }
+
+    // Nodes on the loop of node, counted up to limit; 0 if the loop is broken
+    int loopSize(int node, int limit) const
+    {
+        int num = 1;
+        for (int n = next[node]; n != node && num < limit; n = next[n], ++num)
+        {
+            if (!isAlive(n))
+                return 0;
+        }
+        return num;
+    }
+
+    int firstNode(int v) const
+    {
+        return vertHead[v];
+    }
+
+    int nextSameNode(int node) const
+    {
+        return sameNext[node];
+    }
+
+    void link(int a, int b)
+    {
+        next[a] = b;
+        prev[b] = a;
+    }
+
+    // Loop a -> b -> c of the first triangle of a component; returns the gate
+    int start(int a, int b, int c, int cornerA, int cornerB, int cornerC)
+    {
+        const int nodeA = addNode(a, cornerA);
+        const int nodeB = addNode(b, cornerB);
+        const int nodeC = addNode(c, cornerC);
+        link(nodeA, nodeB);
+        link(nodeB, nodeC);
+        link(nodeC, nodeA);
+        return nodeA;
+    }
+
+    // The triangle across gate u -> v has tip x; cornerUX and cornerXV are its
+    // corners opposite the edges u -> x and x -> v. Each returns the next gate.
+    int opC(int gate, int x, int cornerUX, int cornerXV)
+    {
+        const int nodeX = addNode(x, cornerXV);
+        link(nodeX, next[gate]);
+        link(gate, nodeX);
+        corner[gate] = cornerUX;
+        return gate;
+    }
+
+    int opL(int gate, int cornerXV)
+    {
+        const int nodeX = prev[gate];
+        link(nodeX, next[gate]);
+        corner[nodeX] = cornerXV;
+        removeNode(gate);
+        return nodeX;
+    }
+
+    int opR(int gate, int cornerUX)
+    {
+        const int nodeV = next[gate];
+        link(gate, next[nodeV]);
+        corner[gate] = cornerUX;
+        removeNode(nodeV);
+        return gate;
+    }
+
+    void opE(int gate)
+    {
+        removeNode(prev[gate]);
+        removeNode(next[gate]);
+        removeNode(gate);
+    }
+
+    // x is at nodeX elsewhere on the loop, which splits in two. The part
+    // starting with x -> v is returned through other.
+    int opS(int gate, int nodeX, int cornerUX, int cornerXV, int &other)
+    {
+        const int nodeV = next[gate];
+        const int prevX = prev[nodeX];
+        other           = addNode(vert[nodeX], cornerXV);
+        link(prevX, other);
+        link(other, nodeV);
+        link(gate, nodeX);
+        corner[gate] = cornerUX;
+        return gate;
+    }
+};
+
+void writeStream(std::ostream &out, const std::vector<uint8_t> &stream)
+{
+    out.write(reinterpret_cast<const char *>(stream.data()), static_cast<std::streamsize>(stream.size()));
+}
+
+void writeResidual(std::vector<uint8_t> &stream, const int64_t *val, const int64_t *pred)
+{
+    for (int j = 0; j < 3; ++j)
+        writeSigned(stream, val[j] - pred[j]);
+}
+
+void readResidual(ByteReader &reader, int64_t *val, const int64_t *pred)
+{
+    for (int j = 0; j < 3; ++j)
+        val[j] = pred[j] + reader.readSigned();
+}
+}
+
+void writeCompactMesh(std::ostream &out, const Input &input, const Output &output, const CompactMeshOption &option)
+{
+    if (!(option.step > 0))
+    {
+        throw std::invalid_argument("CompactMesh: quantization step must be positive");
+    }
+
+    const Point  *pointArr = input.points();
+    const int     pointNum = (int)input.pointNum();
+    const Tri    *triArr   = output.tris();
+    const TriOpp *oppArr   = output.triOpps();
+    const int     triNum   = (int)output.triNum();
+
+    // Corner table of the mesh, then closed with one cap fan per boundary loop
+    std::vector<int> cornerVert(3 * (size_t)triNum);
+    std::vector<int> cornerOpp(3 * (size_t)triNum);
+    for (int t = 0; t < triNum; ++t)
+    {
+        for (int vi = 0; vi < 3; ++vi)
+        {
+            cornerVert[3 * t + vi] = triArr[t]._v[vi];
+            cornerOpp[3 * t + vi]  = (-1 == oppArr[t]._t[vi]) ? -1 : 3 * oppArr[t].getOppTri(vi) + oppArr[t].getOppVi(vi);
+        }
+    }
+
+    // Boundary corner whose edge leaves each vertex
+    std::vector<int> boundaryOut(pointNum, -1);
+    for (int c = 0; c < 3 * triNum; ++c)
+    {
+        if (cornerOpp[c] != -1)
+            continue;
+        int &out = boundaryOut[cornerVert[nextCorner(c)]];
+        if (out != -1)
+        {
+            throw std::runtime_error("CompactMesh: boundary is not manifold");
+        }
+        out = c;
+    }
+
+    int capNum = 0;
+    for (int c = 0; c < 3 * triNum; ++c)
+    {
+        if (cornerOpp[c] != -1)
+            continue;
+
+        // Cap b -> a -> cap for every boundary edge a -> b of the loop
+        const int cap      = pointNum + capNum++;
+        const int firstCap = (int)cornerVert.size() / 3;
+        int       loopC    = c;
+        do
+        {
+            const int a   = cornerVert[nextCorner(loopC)];
+            const int b   = cornerVert[prevCorner(loopC)];
+            const int ct  = (int)cornerVert.size() / 3;
+            const int ctc = 3 * ct;
+            cornerVert.insert(cornerVert.end(), {b, a, cap});
+            cornerOpp.insert(cornerOpp.end(), {-1, -1, loopC});
+            cornerOpp[loopC] = ctc + 2;
+            if (ct > firstCap)
+            {
+                cornerOpp[ctc - 2] = ctc;
+                cornerOpp[ctc]     = ctc - 2;
+            }
+            loopC = boundaryOut[b];
+            if (loopC == -1)
+            {
+                throw std::runtime_error("CompactMesh: boundary loop is not closed");
+            }
+        } while (cornerOpp[loopC] == -1);
+
+        const int lastCorner       = (int)cornerVert.size() - 2;
+        cornerOpp[lastCorner]      = 3 * firstCap;
+        cornerOpp[3 * firstCap]    = lastCorner;
+    }
+
+    const size_t         allVertNum = (size_t)pointNum + capNum;
+    const size_t         allTriNum  = cornerVert.size() / 3;
+    std::vector<char>    visited(allTriNum, 0);
+    std::vector<int>     newId(allVertNum, -1);
+    std::vector<int64_t> quantized(3 * (size_t)pointNum);
+
+    double origin[3] = {0, 0, 0};
+    if (pointNum > 0)
+    {
+        for (int j = 0; j < 3; ++j)
+            origin[j] = pointArr[0]._p[j];
+        for (int i = 1; i < pointNum; ++i)
+            for (int j = 0; j < 3; ++j)
+                origin[j] = std::min(origin[j], pointArr[i]._p[j]);
+    }
+    for (int i = 0; i < pointNum; ++i)
+        for (int j = 0; j < 3; ++j)
+            quantized[3 * i + j] = std::llround((pointArr[i]._p[j] - origin[j]) / option.step);
+
+    QuantizedPoints qPoints{quantized, (size_t)pointNum};
+
+    BitWriter            symbols;
+    std::vector<uint8_t> vertexStream;
+    std::vector<uint8_t> refStream;
+    ActiveLoops          loops(allVertNum);
+    std::vector<int>     gateStack;
+
+    int    realNum      = 0;
+    int    capIdx       = 0;
+    int    lastReal     = -1; // Original index of the last numbered point
+    size_t componentNum = 0;
+
+    const int64_t zero[3] = {0, 0, 0};
+
+    auto addReal = [&](int v, const int64_t *pred) {
+        newId[v] = realNum++;
+        writeResidual(vertexStream, qPoints.at(v), pred);
+        lastReal = v;
+    };
+
+    for (int t0 = 0; t0 < triNum; ++t0)
+    {
+        if (visited[t0])
+            continue;
+
+        const int a = cornerVert[3 * t0], b = cornerVert[3 * t0 + 1], c = cornerVert[3 * t0 + 2];
+        if (newId[a] >= 0 || newId[b] >= 0 || newId[c] >= 0)
+        {
+            throw std::runtime_error("CompactMesh: components share a vertex");
+        }
+        for (int v : {a, b, c})
+            addReal(v, (lastReal >= 0) ? qPoints.at(lastReal) : zero);
+
+        visited[t0] = 1;
+        ++componentNum;
+
+        int gate = loops.start(a, b, c, 3 * t0 + 2, 3 * t0, 3 * t0 + 1);
+        while (gate >= 0)
+        {
+            const int ct = cornerOpp[loops.corner[gate]];
+            const int t  = ct / 3;
+            const int u  = loops.vert[gate];
+            const int v  = loops.vert[loops.next[gate]];
+            if (ct < 0 || visited[t] || cornerVert[prevCorner(ct)] != u || cornerVert[nextCorner(ct)] != v)
+            {
+                throw std::runtime_error("CompactMesh: inconsistent adjacency");
+            }
+            visited[t] = 1;
+
+            const int x        = cornerVert[ct];
+            const int cornerUX = nextCorner(ct);
+            const int cornerXV = prevCorner(ct);
+
+            if (newId[x] < 0)
+            {
+                if (x >= pointNum)
+                {
+                    symbols.writeSymbol(SymbolD);
+                    newId[x] = capIdx++;
+                }
+                else
+                {
+                    int64_t pred[3];
+                    qPoints.predict(u, v, cornerVert[loops.corner[gate]], lastReal, pred);
+                    symbols.writeSymbol(SymbolC);
+                    addReal(x, pred);
+                }
+                gate = loops.opC(gate, x, cornerUX, cornerXV);
+                continue;
+            }
+
+            const bool isLeft  = x == loops.vert[loops.prev[gate]];
+            const bool isRight = x == loops.vert[loops.next[loops.next[gate]]];
+            if (isLeft && isRight)
+            {
+                if (loops.prev[gate] != loops.next[loops.next[gate]])
+                {
+                    throw std::runtime_error("CompactMesh: mesh is not manifold");
+                }
+                symbols.writeSymbol(SymbolE);
+                loops.opE(gate);
+                gate = -1;
+                if (!gateStack.empty())
+                {
+                    gate = gateStack.back();
+                    gateStack.pop_back();
+                }
+            }
+            else if (isLeft)
+            {
+                symbols.writeSymbol(SymbolL);
+                gate = loops.opL(gate, cornerXV);
+            }
+            else if (isRight)
+            {
+                symbols.writeSymbol(SymbolR);
+                gate = loops.opR(gate, cornerUX);
+            }
+            else
+            {
+                // Find the occurrence of x whose wedge of remaining triangles
+                // holds this one, by turning around x from its outgoing edge
+                int nodeX = -1, occurrence = 0, occurrenceNum = 0;
+                for (int node = loops.firstNode(x); node >= 0; node = loops.nextSameNode(node), ++occurrenceNum)
+                {
+                    if (nodeX >= 0)
+                        continue;
+                    for (int wc = cornerOpp[loops.corner[node]]; wc >= 0; wc = cornerOpp[nextCorner(wc)])
+                    {
+                        if (wc / 3 == t)
+                        {
+                            nodeX      = node;
+                            occurrence = occurrenceNum;
+                            break;
+                        }
+                        if (visited[wc / 3])
+                            break;
+                    }
+                }
+                if (nodeX < 0)
+                {
+                    throw std::runtime_error("CompactMesh: mesh is not a manifold of genus 0");
+                }
+
+                symbols.writeSymbol(SymbolS);
+                if (x >= pointNum)
+                    writeVarint(refStream, ((uint64_t)newId[x] << 1) | 1);
+                else
+                    writeVarint(refStream, (uint64_t)(realNum - 1 - newId[x]) << 1);
+                if (occurrenceNum > 1)
+                    writeVarint(refStream, occurrence);
+
+                int other;
+                gate = loops.opS(gate, nodeX, cornerUX, cornerXV, other);
+                gateStack.push_back(other);
+            }
+        }
+    }
+
+    const int usedPointNum = realNum;
+    for (int i = 0; i < pointNum; ++i)
+    {
+        if (newId[i] < 0)
+            addReal(i, (lastReal >= 0) ? qPoints.at(lastReal) : zero);
+    }
+
+    std::vector<uint8_t> constraintStream;
+    const Edge          *consArr = input.constraints();
+    for (size_t i = 0; i < input.constraintNum(); ++i)
+    {
+        writeVarint(constraintStream, newId[consArr[i]._v[0]]);
+        writeVarint(constraintStream, newId[consArr[i]._v[1]]);
+    }
+
+    CompactMeshHeader header{};
+    std::memcpy(header.magic, CompactMeshMagic, sizeof(header.magic));
+    header.version        = CompactMeshVersion;
+    header.pointNum       = pointNum;
+    header.usedPointNum   = usedPointNum;
+    header.triNum         = triNum;
+    header.constraintNum  = input.constraintNum();
+    header.componentNum   = componentNum;
+    header.capNum         = capNum;
+    header.step           = option.step;
+    header.infPt          = output.infPt;
+    header.symbolSize     = symbols.data().size();
+    header.vertexSize     = vertexStream.size();
+    header.refSize        = refStream.size();
+    header.constraintSize = constraintStream.size();
+    for (int j = 0; j < 3; ++j)
+        header.origin[j] = origin[j];
+
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    writeStream(out, symbols.data());
+    writeStream(out, vertexStream);
+    writeStream(out, refStream);
+    writeStream(out, constraintStream);
+
+    if (!out)
+    {
+        throw std::runtime_error("CompactMesh: failed writing mesh data");
+    }
+}
+
+bool isCompactMesh(const std::string &filename)
+{
+    std::ifstream inFile(filename, std::ios::binary);
+    char          magic[4] = {};
+    inFile.read(magic, sizeof(magic));
+    return inFile && std::memcmp(magic, CompactMeshMagic, sizeof(magic)) == 0;
+}
+
+void readCompactMesh(const std::string &filename, Input &input, Output &output)
+{
+    const MappedFile file(filename);
+
+    CompactMeshHeader header;
+    if (file.size() < sizeof(header))
+    {
+        throw std::runtime_error("CompactMesh: file too small for a header");
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, CompactMeshMagic, sizeof(header.magic)) != 0)
+    {
+        throw std::runtime_error("CompactMesh: bad magic");
+    }
+    if (header.version != CompactMeshVersion)
+    {
+        throw std::runtime_error("CompactMesh: unsupported version " + std::to_string(header.version));
+    }
+    const uint64_t streamSize = header.symbolSize + header.vertexSize + header.refSize + header.constraintSize;
+    // Every point takes at least 3 residual bytes and every constraint 2, and
+    // a genus-0 mesh has fewer triangles or boundary loops than that bounds
+    if (header.symbolSize > file.size() || header.vertexSize > file.size() || header.refSize > file.size() ||
+        header.constraintSize > file.size() || streamSize > file.size() - sizeof(header) ||
+        header.usedPointNum > header.pointNum || header.pointNum > header.vertexSize / 3 ||
+        header.triNum > 2 * header.usedPointNum || header.capNum > header.usedPointNum ||
+        header.constraintNum > header.constraintSize / 2)
+    {
+        throw std::runtime_error("CompactMesh: truncated or corrupted file");
+    }
+
+    const auto *streamBegin = reinterpret_cast<const uint8_t *>(file.data() + sizeof(header));
+    BitReader   symbols(streamBegin, header.symbolSize);
+    ByteReader  vertexReader(streamBegin + header.symbolSize, header.vertexSize);
+    ByteReader  refReader(streamBegin + header.symbolSize + header.vertexSize, header.refSize);
+    ByteReader  constraintReader(streamBegin + header.symbolSize + header.vertexSize + header.refSize,
+                                header.constraintSize);
+
+    const int usedPointNum = (int)header.usedPointNum;
+    const int pointNum     = (int)header.pointNum;
+    const int capNum       = (int)header.capNum;
+
+    QuantizedPoints  qPoints{std::vector<int64_t>(3 * (size_t)pointNum), (size_t)usedPointNum};
+    std::vector<int> cornerVert;
+    std::vector<int> cornerOpp;
+    cornerVert.reserve(3 * (header.triNum + header.triNum / 8));
+    cornerOpp.reserve(cornerVert.capacity());
+
+    ActiveLoops      loops((size_t)usedPointNum + capNum);
+    std::vector<int> gateStack;
+
+    int realNum = 0;
+    int capIdx  = 0;
+
+    const int64_t zero[3] = {0, 0, 0};
+
+    auto addReal = [&](const int64_t *pred) {
+        if (realNum >= pointNum)
+        {
+            throw std::runtime_error("CompactMesh: too many points");
+        }
+        readResidual(vertexReader, qPoints.at(realNum), pred);
+        return realNum++;
+    };
+    // Points of the traversal, which the loops have room for
+    auto addUsed = [&](const int64_t *pred) {
+        if (realNum >= usedPointNum)
+        {
+            throw std::runtime_error("CompactMesh: too many points");
+        }
+        return addReal(pred);
+    };
+    auto lastPred = [&]() { return (realNum > 0) ? qPoints.at(realNum - 1) : zero; };
+    auto glue     = [&](int c0, int c1) {
+        cornerOpp[c0] = c1;
+        cornerOpp[c1] = c0;
+    };
+
+    for (uint64_t comp = 0; comp < header.componentNum; ++comp)
+    {
+        const int a = addUsed(lastPred());
+        const int b = addUsed(lastPred());
+        const int c = addUsed(lastPred());
+
+        const int t0 = (int)cornerVert.size() / 3;
+        cornerVert.insert(cornerVert.end(), {a, b, c});
+        cornerOpp.insert(cornerOpp.end(), {-1, -1, -1});
+
+        int gate = loops.start(a, b, c, 3 * t0 + 2, 3 * t0, 3 * t0 + 1);
+        while (gate >= 0)
+        {
+            const Symbol symbol = symbols.readSymbol();
+
+            // A corrupted stream must not run an op the loop cannot hold: L
+            // and R need a fourth node, E closes a loop of exactly three
+            const int loopSize = loops.isAlive(gate) ? loops.loopSize(gate, 4) : 0;
+            if (loopSize < 3 || ((symbol == SymbolL || symbol == SymbolR) && loopSize < 4) ||
+                (symbol == SymbolE && loopSize != 3))
+            {
+                throw std::runtime_error("CompactMesh: symbol does not fit the boundary loop");
+            }
+
+            const int    u      = loops.vert[gate];
+            const int    v      = loops.vert[loops.next[gate]];
+            const int    gateC  = loops.corner[gate];
+
+            int x     = -1;
+            int nodeX = -1;
+            switch (symbol)
+            {
+            case SymbolC:
+            {
+                int64_t pred[3];
+                qPoints.predict(u, v, cornerVert[gateC], realNum - 1, pred);
+                x = addUsed(pred);
+                break;
+            }
+            case SymbolD:
+                if (capIdx >= capNum)
+                {
+                    throw std::runtime_error("CompactMesh: too many cap vertices");
+                }
+                x = usedPointNum + capIdx++;
+                break;
+            case SymbolL:
+            case SymbolE:
+                x = loops.vert[loops.prev[gate]];
+                break;
+            case SymbolR:
+                x = loops.vert[loops.next[loops.next[gate]]];
+                break;
+            case SymbolS:
+            {
+                const uint64_t ref = refReader.readVarint();
+                const uint64_t idx = ref >> 1;
+                if ((ref & 1) ? idx >= (uint64_t)capIdx : idx >= (uint64_t)realNum)
+                {
+                    throw std::runtime_error("CompactMesh: bad vertex reference");
+                }
+                x = (ref & 1) ? usedPointNum + (int)idx : realNum - 1 - (int)idx;
+
+                int occurrenceNum = 0;
+                for (int node = loops.firstNode(x); node >= 0; node = loops.nextSameNode(node))
+                    ++occurrenceNum;
+                const uint64_t occurrence = (occurrenceNum > 1) ? refReader.readVarint() : 0;
+                nodeX                     = loops.firstNode(x);
+                for (uint64_t i = 0; i < occurrence && nodeX >= 0; ++i)
+                    nodeX = loops.nextSameNode(nodeX);
+                if (nodeX < 0 || x == u || x == v || x == loops.vert[loops.prev[gate]] ||
+                    x == loops.vert[loops.next[loops.next[gate]]])
+                {
+                    throw std::runtime_error("CompactMesh: bad vertex reference");
+                }
+                break;
+            }
+            }
+
+            const int t        = (int)cornerVert.size() / 3;
+            const int cornerUX = 3 * t;
+            const int cornerXV = 3 * t + 1;
+            cornerVert.insert(cornerVert.end(), {v, u, x});
+            cornerOpp.insert(cornerOpp.end(), {-1, -1, -1});
+            glue(3 * t + 2, gateC);
+
+            switch (symbol)
+            {
+            case SymbolC:
+            case SymbolD:
+                gate = loops.opC(gate, x, cornerUX, cornerXV);
+                break;
+            case SymbolL:
+                glue(cornerUX, loops.corner[loops.prev[gate]]);
+                gate = loops.opL(gate, cornerXV);
+                break;
+            case SymbolR:
+                glue(cornerXV, loops.corner[loops.next[gate]]);
+                gate = loops.opR(gate, cornerUX);
+                break;
+            case SymbolE:
+                glue(cornerUX, loops.corner[loops.prev[gate]]);
+                glue(cornerXV, loops.corner[loops.next[gate]]);
+                loops.opE(gate);
+                gate = -1;
+                if (!gateStack.empty())
+                {
+                    gate = gateStack.back();
+                    gateStack.pop_back();
+                }
+                break;
+            case SymbolS:
+            {
+                int other;
+                gate = loops.opS(gate, nodeX, cornerUX, cornerXV, other);
+                gateStack.push_back(other);
+                break;
+            }
+            }
+        }
+    }
+
+    if (realNum != usedPointNum || capIdx != capNum)
+    {
+        throw std::runtime_error("CompactMesh: point count mismatch");
+    }
+    while (realNum < pointNum)
+        addReal(lastPred());
+
+    // Drop the caps and renumber the remaining triangles
+    const int        allTriNum = (int)cornerVert.size() / 3;
+    std::vector<int> triMap(allTriNum, -1);
+    int              triNum = 0;
+    for (int t = 0; t < allTriNum; ++t)
+    {
+        if (cornerVert[3 * t] < usedPointNum && cornerVert[3 * t + 1] < usedPointNum &&
+            cornerVert[3 * t + 2] < usedPointNum)
+            triMap[t] = triNum++;
+    }
+    if ((uint64_t)triNum != header.triNum)
+    {
+        throw std::runtime_error("CompactMesh: triangle count mismatch");
+    }
+
+    input.unmap();
+    input.pointVec.resize(pointNum);
+    for (int i = 0; i < pointNum; ++i)
+        for (int j = 0; j < 3; ++j)
+            input.pointVec[i]._p[j] = header.origin[j] + header.step * qPoints.at(i)[j];
+
+    input.constraintVec.resize(header.constraintNum);
+    for (auto &edge : input.constraintVec)
+    {
+        for (int &v : edge._v)
+        {
+            const uint64_t id = constraintReader.readVarint();
+            if (id >= (uint64_t)pointNum)
+            {
+                throw std::runtime_error("CompactMesh: bad constraint vertex");
+            }
+            v = (int)id;
+        }
+    }
+
+    output.reset();
+    output.infPt = header.infPt;
+    output.triVec.resize(triNum);
+    output.triOppVec.resize(triNum);
+    for (int t = 0; t < allTriNum; ++t)
+    {
+        const int ti = triMap[t];
+        if (ti < 0)
+            continue;
+        for (int vi = 0; vi < 3; ++vi)
+        {
+            const int c = 3 * t + vi;
+            output.triVec[ti]._v[vi] = cornerVert[c];
+            const int oppTi          = (cornerOpp[c] < 0) ? -1 : triMap[cornerOpp[c] / 3];
+            if (oppTi < 0)
+                output.triOppVec[ti]._t[vi] = -1;
+            else
+                output.triOppVec[ti].setOpp(vi, oppTi, cornerOpp[c] % 3);
+        }
+    }
+
+    // Restore the constraint bits of the adjacency
+    if (!input.constraintVec.empty())
+    {
+        const VertexTriIndex vertTriIndex(output.triVec, pointNum);
+        for (const Edge &edge : input.constraintVec)
+        {
+            int       vi = -1;
+            const int ti = vertTriIndex.findEdge(edge._v[0], edge._v[1], vi);
+            if (ti < 0)
+                continue;
+            TriOpp &opp = output.triOppVec[ti];
+            opp.setOppConstraint(vi, true);
+            if (-1 != opp._t[vi])
+                output.triOppVec[opp.getOppTri(vi)].setOppConstraint(opp.getOppVi(vi), true);
+        }
+    }
+}
+}
@@ -1,63 +1,116 @@
 #include "../include/DelaunayChecker.h"
 #include "../../inc/json.h"
+#include "../include/HostParallel.h"
+#include "../include/VertexTriIndex.h"
+#include "../include/HashFunctors.h"
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <unordered_set>
 
 namespace gdg
 {
+namespace
+{
+// Draw sampleNum of the num indices, an equal share uniformly from each of
+// strataNum consecutive index ranges; all of them if sampleNum reaches num
+std::vector<int> stratifiedSample(long long num, long long sampleNum, int strataNum, std::mt19937_64 &rng)
+{
+    std::vector<int> sampleVec;
+    if (sampleNum >= num)
+    {
+        sampleVec.resize(num);
+        for (int i = 0; i < num; ++i)
+            sampleVec[i] = i;
+        return sampleVec;
+    }
+
+    strataNum = (int)std::max(1LL, std::min<long long>(strataNum, sampleNum));
+    sampleVec.reserve(sampleNum);
+    for (int s = 0; s < strataNum; ++s)
+    {
+        const long long begin = num * s / strataNum;
+        const long long end   = num * (s + 1) / strataNum;
+        const long long count = sampleNum * (s + 1) / strataNum - sampleNum * s / strataNum;
+
+        std::uniform_int_distribution<long long> dist(begin, end - 1);
+        for (long long i = 0; i < count; ++i)
+            sampleVec.push_back((int)dist(rng));
+    }
+    return sampleVec;
+}
+}
+
 DelaunayChecker::DelaunayChecker(const Input &inputRef, Output &outputRef)
-    : input(inputRef), output(outputRef), predWrapper(inputRef.pointVec, outputRef.infPt)
+    : input(inputRef), output(outputRef), predWrapper(inputRef.points(), inputRef.pointNum(), outputRef.infPt)
 {
 }
 
 size_t DelaunayChecker::getVertexCount() const
 {
-    const TriHVec &triVec = output.triVec;
-    std::set<int>  vertSet;
-    // Add vertices
-    for (auto tri : triVec)
-    {
-        vertSet.insert(tri._v, tri._v + DEG);
-    }
-    return vertSet.size();
+    const Tri    *triArr  = output.tris();
+    const size_t  wordNum = (predWrapper.pointNum() + 63) / 64;
+
+    // Vertex bitmap, value-initialized to zero
+    std::unique_ptr<std::atomic<uint64_t>[]> vertBits(new std::atomic<uint64_t>[wordNum]());
+
+    parallelFor(output.triNum(), [&](int, size_t begin, size_t end) {
+        for (size_t ti = begin; ti < end; ++ti)
+            for (int v : triArr[ti]._v)
+                vertBits[v >> 6].fetch_or(uint64_t(1) << (v & 63), std::memory_order_relaxed);
+    });
+
+    return parallelSum<size_t>(wordNum, [&](size_t begin, size_t end) {
+        size_t count = 0;
+        for (size_t i = begin; i < end; ++i)
+            count += __builtin_popcountll(vertBits[i].load(std::memory_order_relaxed));
+        return count;
+    });
 }
 
 size_t DelaunayChecker::getSegmentCount() const
 {
-    const TriHVec &triVec = output.triVec;
-    const int      triNum = (int)triVec.size();
-
-    std::set<Edge> segSet;
-
-    //    // Read segments
-    //    Edge segArr[TriSegNum];
-    //    for (int ti = 0; ti < triNum; ++ti)
-    //    {
-    //        const Tri &tri = triVec[ti];
-    //        GpuDel::getEdges(tri, segArr);
-    //        segSet.insert(segArr, segArr + TriSegNum);
-    //    }
-    return segSet.size();
+    const TriOpp *oppArr = output.triOpps();
+
+    // A boundary edge has no opposite triangle, an interior edge is counted
+    // from the side with the lower triangle index
+    return parallelSum<size_t>(output.triNum(), [&](size_t begin, size_t end) {
+        size_t count = 0;
+        for (size_t ti = begin; ti < end; ++ti)
+            for (int vi = 0; vi < DEG; ++vi)
+                if (-1 == oppArr[ti]._t[vi] || (int)ti < oppArr[ti].getOppTri(vi))
+                    ++count;
+        return count;
+    });
 }
 
-size_t DelaunayChecker::getTriangleCount()
+size_t DelaunayChecker::getTriangleCount() const
 {
-    return output.triVec.size();
+    return output.triNum();
 }
 
-void DelaunayChecker::checkEuler()
+void DelaunayChecker::checkEuler() const
 {
-    const auto v = getVertexCount();
-    std::cout << "Vertex: " << v;
+    PerfTimer timer;
+    timer.start();
 
+    const auto v = getVertexCount();
     const auto e = getSegmentCount();
-    std::cout << " Edge: " << e;
-
     const auto f = getTriangleCount();
-    std::cout << " Triangle: " << f;
 
-    const auto euler = v - e + f;
+    const auto euler = (long long)v - (long long)e + (long long)f;
+
+    timer.stop();
+
+    std::cout << "Vertex: " << v;
+    std::cout << " Edge: " << e;
+    std::cout << " Triangle: " << f;
     std::cout << " Euler: " << euler << std::endl;
 
-    std::cout << "Euler check: " << ((1 != euler) ? " ***Fail***" : " Pass") << std::endl;
+    std::cout << "Euler check: " << ((1 != euler) ? " ***Fail***" : " Pass") << " (" << timer.value() << " ms)"
+              << std::endl;
 }
 
 void printTriAndOpp(int ti, const Tri &tri, const TriOpp &opp)
@@ -77,242 +130,442 @@ void printTriAndOpp(int ti, const Tri &tri, const TriOpp &opp)
 
 void DelaunayChecker::checkAdjacency() const
 {
-    const TriHVec    triVec = output.triVec;
-    const TriOppHVec oppVec = output.triOppVec;
+    const Tri    *triArr = output.tris();
+    const TriOpp *oppArr = output.triOpps();
 
-    for (int ti0 = 0; ti0 < (int)triVec.size(); ++ti0)
-    {
-        const Tri    &tri0 = triVec[ti0];
-        const TriOpp &opp0 = oppVec[ti0];
+    PerfTimer  timer;
+    std::mutex printMutex;
+    timer.start();
 
-        for (int vi = 0; vi < DEG; ++vi)
+    const int failNum = parallelSum<int>((int)output.triNum(), [&](int begin, int end) {
+        int fail = 0;
+
+        for (int ti0 = begin; ti0 < end; ++ti0)
         {
-            if (-1 == opp0._t[vi])
-                continue;
+            const Tri    &tri0 = triArr[ti0];
+            const TriOpp &opp0 = oppArr[ti0];
 
-            const int ti1   = opp0.getOppTri(vi);
-            const int vi0_1 = opp0.getOppVi(vi);
+            for (int vi = 0; vi < DEG; ++vi)
+            {
+                if (-1 == opp0._t[vi])
+                    continue;
 
-            const Tri    &tri1 = triVec[ti1];
-            const TriOpp &opp1 = oppVec[ti1];
+                const int ti1   = opp0.getOppTri(vi);
+                const int vi0_1 = opp0.getOppVi(vi);
 
-            if (-1 == opp1._t[vi0_1])
-            {
-                std::cout << "Fail4!" << std::endl;
-                continue;
-            }
+                const Tri    &tri1 = triArr[ti1];
+                const TriOpp &opp1 = oppArr[ti1];
 
-            if (ti0 != opp1.getOppTri(vi0_1))
-            {
-                std::cout << "Not opp of each other! Tri0: " << ti0 << " Tri1: " << ti1 << std::endl;
-                printTriAndOpp(ti0, tri0, opp0);
-                printTriAndOpp(ti1, tri1, opp1);
-                continue;
-            }
+                if (-1 == opp1._t[vi0_1])
+                {
+                    std::lock_guard<std::mutex> lock(printMutex);
+                    std::cout << "Fail4!" << std::endl;
+                    ++fail;
+                    continue;
+                }
 
-            if (vi != opp1.getOppVi(vi0_1))
-            {
-                std::cout << "Vi mismatch! Tri0: " << ti0 << "Tri1: " << ti1 << std::endl;
-                continue;
+                if (ti0 != opp1.getOppTri(vi0_1))
+                {
+                    std::lock_guard<std::mutex> lock(printMutex);
+                    std::cout << "Not opp of each other! Tri0: " << ti0 << " Tri1: " << ti1 << std::endl;
+                    printTriAndOpp(ti0, tri0, opp0);
+                    printTriAndOpp(ti1, tri1, opp1);
+                    ++fail;
+                    continue;
+                }
+
+                if (vi != opp1.getOppVi(vi0_1))
+                {
+                    std::lock_guard<std::mutex> lock(printMutex);
+                    std::cout << "Vi mismatch! Tri0: " << ti0 << "Tri1: " << ti1 << std::endl;
+                    ++fail;
+                    continue;
+                }
             }
         }
-    }
 
-    std::cout << "Adjacency check: Pass\n";
+        return fail;
+    });
+
+    timer.stop();
+
+    std::cout << "Adjacency check: ";
+    if (failNum)
+        std::cout << "***Fail*** Broken adjacencies: " << failNum;
+    else
+        std::cout << "Pass";
+    std::cout << " (" << timer.value() << " ms)\n";
 }
 
 void DelaunayChecker::checkOrientation()
 {
-    const TriHVec triVec = output.triVec;
+    const Tri *triArr = output.tris();
 
-    int count = 0;
+    PerfTimer timer;
+    timer.start();
 
-    for (auto t : triVec)
-    {
-        const Orient ord = predWrapper.doOrient2DFastExactSoS(t._v[0], t._v[1], t._v[2]);
-        if (OrientNeg == ord)
-            ++count;
-    }
+    const int count = parallelSum<int>((int)output.triNum(), [&](int begin, int end) {
+        int wrong = 0;
+
+        // Triangles touching the infinity point (normally none in the output)
+        // go through the slow path afterwards
+        std::vector<int> infTriVec;
+
+        for (int ti = begin; ti < end; ++ti)
+        {
+            const Tri &t = triArr[ti];
+
+            if (predWrapper.isInfTri(t))
+            {
+                infTriVec.push_back(ti);
+                continue;
+            }
+
+            const Orient ord = predWrapper.doOrient2DFastExactSoS<HasInf::No>(t._v[0], t._v[1], t._v[2]);
+            if (OrientNeg == ord)
+                ++wrong;
+        }
+
+        for (int ti : infTriVec)
+        {
+            const Tri   &t   = triArr[ti];
+            const Orient ord = predWrapper.doOrient2DFastExactSoS<HasInf::Yes>(t._v[0], t._v[1], t._v[2]);
+            if (OrientNeg == ord)
+                ++wrong;
+        }
+
+        return wrong;
+    });
+
+    timer.stop();
 
     std::cout << "Orient check: ";
     if (count)
         std::cout << "***Fail*** Wrong orient: " << count;
     else
         std::cout << "Pass";
-    std::cout << "\n";
+    std::cout << " (" << timer.value() << " ms)\n";
 }
 
 void DelaunayChecker::checkDelaunay()
 {
-    const TriHVec    triVec = output.triVec;
-    const TriOppHVec oppVec = output.triOppVec;
+    const Tri    *triArr = output.tris();
+    const TriOpp *oppArr = output.triOpps();
 
-    const int triNum  = (int)triVec.size();
-    int       failNum = 0;
+    PerfTimer timer;
+    timer.start();
 
-    for (int botTi = 0; botTi < triNum; ++botTi)
-    {
-        const Tri    botTri = triVec[botTi];
-        const TriOpp botOpp = oppVec[botTi];
+    const int failNum = parallelSum<int>((int)output.triNum(), [&](int begin, int end) {
+        int fail = 0;
 
-        for (int botVi = 0; botVi < DEG; ++botVi) // Face neighbours
+        for (int botTi = begin; botTi < end; ++botTi)
         {
-            // No face neighbour or facing constraint
-            if (-1 == botOpp._t[botVi] || botOpp.isOppConstraint(botVi))
-                continue;
+            const Tri    &botTri = triArr[botTi];
+            const TriOpp &botOpp = oppArr[botTi];
+            const bool    botInf = predWrapper.isInfTri(botTri);
 
-            const int topVi = botOpp.getOppVi(botVi);
-            const int topTi = botOpp.getOppTri(botVi);
+            for (int botVi = 0; botVi < DEG; ++botVi) // Face neighbours
+            {
+                // No face neighbour or facing constraint
+                if (-1 == botOpp._t[botVi] || botOpp.isOppConstraint(botVi))
+                    continue;
 
-            if (topTi < botTi)
-                continue; // Neighbour will check
+                const int topVi = botOpp.getOppVi(botVi);
+                const int topTi = botOpp.getOppTri(botVi);
 
-            const Tri  topTri  = triVec[topTi];
-            const int  topVert = topTri._v[topVi];
-            const Side side    = predWrapper.doIncircle(botTri, topVert);
+                if (topTi < botTi)
+                    continue; // Neighbour will check
 
-            if (SideIn != side)
-                continue;
+                const int  topVert = triArr[topTi]._v[topVi];
+                const Side side    = (botInf || predWrapper.isInfVert(topVert))
+                                         ? predWrapper.doIncircle<HasInf::Yes>(botTri, topVert)
+                                         : predWrapper.doIncircle<HasInf::No>(botTri, topVert);
+
+                if (SideIn != side)
+                    continue;
 
-            ++failNum;
+                ++fail;
+            }
         }
-    }
+
+        return fail;
+    });
+
+    timer.stop();
 
     std::cout << "\nDelaunay check: ";
 
     if (failNum == 0)
-        std::cout << "Pass" << std::endl;
+        std::cout << "Pass";
     else
-        std::cout << "***Fail*** Failed faces: " << failNum << std::endl;
+        std::cout << "***Fail*** Failed faces: " << failNum;
+    std::cout << " (" << timer.value() << " ms)" << std::endl;
 }
 
 void DelaunayChecker::checkConstraints()
 {
-    if (input.constraintVec.empty())
+    if (input.constraintNum() == 0)
         return;
 
-    const TriHVec  triVec  = output.triVec;
+    // The constraint bits are rewritten, so a mapped mesh is copied first
+    output.unmap();
+
+    const TriHVec &triVec  = output.triVec;
     TriOppHVec    &oppVec  = output.triOppVec;
-    const EdgeHVec consVec = input.constraintVec;
+    const Edge    *consArr = input.constraints();
+
+    const int triNum = (int)triVec.size();
+    const int conNum = (int)input.constraintNum();
 
-    const int triNum  = (int)triVec.size();
-    int       failNum = 0;
+    PerfTimer timer;
+    timer.start();
 
     // Clear any existing opp constraint info.
-    for (int i = 0; i < triNum; ++i)
-        for (int j = 0; j < 3; ++j)
-            if (oppVec[i]._t[j] != -1)
-                oppVec[i].setOppConstraint(j, false);
+    parallelFor(triNum, [&](int, int begin, int end) {
+        for (int i = begin; i < end; ++i)
+            for (int j = 0; j < 3; ++j)
+                if (oppVec[i]._t[j] != -1)
+                    oppVec[i].setOppConstraint(j, false);
+    });
 
-    // Create a vertex to triangle map
-    IntHVec vertTriMap(predWrapper.pointNum(), -1);
+    const VertexTriIndex vertTriIndex(triVec, predWrapper.pointNum());
 
-    for (int i = 0; i < triNum; ++i)
-        for (int v : triVec[i]._v)
-            vertTriMap[v] = i;
+    // Found constraint edges as (triIdx, vi), marked once all threads are done
+    std::vector<std::vector<std::pair<int, int>>> foundVec(parallelThreadNum(conNum));
+    std::vector<int>                              failVec(foundVec.size(), 0);
 
     // Check the constraints
-    for (int i = 0; i < consVec.size(); ++i)
-    {
-        Edge constraint = consVec[i];
+    parallelFor(conNum, [&](int t, int begin, int end) {
+        for (int i = begin; i < end; ++i)
+        {
+            const Edge constraint = consArr[i];
 
-        const int startIdx = vertTriMap[constraint._v[0]];
+            int       vi     = -1;
+            const int triIdx = vertTriIndex.findEdge(constraint._v[0], constraint._v[1], vi);
 
-        if (startIdx < 0)
-        {
-            ++failNum;
-            continue;
+            if (triIdx < 0)
+                ++failVec[t];
+            else
+                foundVec[t].emplace_back(triIdx, vi);
         }
+    });
 
-        int triIdx = startIdx;
-        int vi     = triVec[triIdx].getIndexOf(constraint._v[0]);
+    int failNum = 0;
 
-        // Walk around the starting vertex to find the constraint edge
-        const int MaxWalking = 1000000;
-        int       j          = 0;
+    for (std::size_t t = 0; t < foundVec.size(); ++t)
+    {
+        failNum += failVec[t];
 
-        for (; j < MaxWalking; ++j)
+        for (const auto &found : foundVec[t])
         {
-            const Tri &tri      = triVec[triIdx];
-            TriOpp    &opp      = oppVec[triIdx];
-            const int  nextVert = tri._v[(vi + 2) % 3];
+            TriOpp &opp = oppVec[found.first];
 
-            // The constraint is already inserted
-            if (nextVert == constraint._v[1])
-            {
-                vi = (vi + 1) % DEG;
-                j  = INT_MAX;
-                break;
-            }
+            opp.setOppConstraint(found.second, true);
 
-            // Rotate
-            if (opp._t[(vi + 1) % DEG] == -1)
-                break;
+            // Constraint on the boundary
+            if (-1 == opp._t[found.second])
+                continue;
 
-            triIdx = opp.getOppTri((vi + 1) % DEG);
-            vi     = opp.getOppVi((vi + 1) % DEG);
-            vi     = (vi + 1) % DEG;
+            const int oppTri = opp.getOppTri(found.second);
+            const int oppVi  = opp.getOppVi(found.second);
 
-            if (triIdx == startIdx)
-                break;
+            oppVec[oppTri].setOppConstraint(oppVi, true);
         }
+    }
 
-        // If not found, rotate the other direction
-        if (j < MaxWalking)
-        {
-            triIdx = startIdx;
-            vi     = triVec[triIdx].getIndexOf(constraint._v[0]);
+    timer.stop();
 
-            for (; j < MaxWalking; ++j)
-            {
-                const Tri &tri      = triVec[triIdx];
-                const int  nextVert = tri._v[(vi + 1) % 3];
+    std::cout << "\nConstraint check: ";
 
-                if (nextVert == constraint._v[1])
-                {
-                    vi = (vi + 2) % DEG;
-                    j  = INT_MAX;
-                    break;
-                }
+    if (failNum == 0)
+        std::cout << "Pass";
+    else
+        std::cout << "***Fail*** Missing constraints: " << failNum;
+    std::cout << " (" << timer.value() << " ms)" << std::endl;
+}
 
-                // Rotate
-                const TriOpp &opp = oppVec[triIdx];
+// Orientation and Delaunay property of one triangle against all its neighbours
+bool DelaunayChecker::isTriFailing(int ti) const
+{
+    const Tri    &tri    = output.tris()[ti];
+    const TriOpp &opp    = output.triOpps()[ti];
+    const bool    triInf = predWrapper.isInfTri(tri);
+
+    const Orient ord = triInf ? predWrapper.doOrient2DFastExactSoS<HasInf::Yes>(tri._v[0], tri._v[1], tri._v[2])
+                              : predWrapper.doOrient2DFastExactSoS<HasInf::No>(tri._v[0], tri._v[1], tri._v[2]);
+    if (OrientNeg == ord)
+        return true;
+
+    for (int vi = 0; vi < DEG; ++vi)
+    {
+        if (-1 == opp._t[vi] || opp.isOppConstraint(vi))
+            continue;
 
-                if (opp._t[(vi + 2) % DEG] == -1)
-                    break;
+        const int  topVert = output.tris()[opp.getOppTri(vi)]._v[opp.getOppVi(vi)];
+        const Side side    = (triInf || predWrapper.isInfVert(topVert))
+                                 ? predWrapper.doIncircle<HasInf::Yes>(tri, topVert)
+                                 : predWrapper.doIncircle<HasInf::No>(tri, topVert);
+        if (SideIn == side)
+            return true;
+    }
+
+    return false;
+}
+
+// Breadth-first walk over the adjacency from a failing triangle, checking
+// every triangle met until maxNum triangles are checked
+void DelaunayChecker::checkNeighbourhood(int                startTi,
+                                         int                maxNum,
+                                         std::vector<char> &visited,
+                                         SampleCheckResult &result) const
+{
+    std::queue<int> triQue;
+    int             checkNum = 0;
 
-                triIdx = opp.getOppTri((vi + 2) % DEG);
-                vi     = opp.getOppVi((vi + 2) % DEG);
-                vi     = (vi + 2) % DEG;
+    if (visited[startTi])
+        return;
+
+    visited[startTi] = 1;
+    triQue.push(startTi);
+
+    while (!triQue.empty() && checkNum < maxNum)
+    {
+        const int ti = triQue.front();
+        triQue.pop();
+
+        ++checkNum;
+        if (isTriFailing(ti))
+            ++result.escalatedFailNum;
+
+        const TriOpp &opp = output.triOpps()[ti];
+        for (int vi = 0; vi < DEG; ++vi)
+        {
+            if (-1 == opp._t[vi])
+                continue;
 
-                if (triIdx == startIdx)
-                    break;
+            const int nextTi = opp.getOppTri(vi);
+            if (!visited[nextTi])
+            {
+                visited[nextTi] = 1;
+                triQue.push(nextTi);
             }
         }
+    }
 
-        if (j == INT_MAX) // Found
-        {
-            TriOpp &opp = oppVec[triIdx];
+    result.escalatedNum += checkNum;
+}
+
+SampleCheckResult DelaunayChecker::checkSampled(const SampleCheckOption &option) const
+{
+    const Tri  *triArr  = output.tris();
+    const Edge *consArr = input.constraints();
+    const auto  triNum  = (long long)output.triNum();
+    const auto  conNum  = (long long)input.constraintNum();
 
-            const int oppTri = opp.getOppTri(vi);
-            const int oppVi  = opp.getOppVi(vi);
+    if (!(option.confidence > 0 && option.confidence < 1))
+        throw std::invalid_argument("DelaunayChecker: sample confidence must be in (0, 1)");
+    if (!(option.tolerance > 0 && option.tolerance < 1))
+        throw std::invalid_argument("DelaunayChecker: sample tolerance must be in (0, 1)");
 
-            opp.setOppConstraint(vi, true);
-            oppVec[oppTri].setOppConstraint(oppVi, true);
+    SampleCheckResult result;
+    PerfTimer         timer;
+    timer.start();
+
+    // Number of samples so that a failure rate of at least tolerance shows up
+    // at least once with the given confidence
+    const double    needed    = std::ceil(std::log1p(-option.confidence) / std::log1p(-option.tolerance));
+    const long long sampleNum = std::min<long long>(triNum, (long long)std::min<double>(needed, (double)triNum));
+
+    std::mt19937_64 rng(option.seed);
+
+    // Stratified sample of triangles, the whole mesh if it is small enough
+    const std::vector<int> sampleVec = stratifiedSample(triNum, sampleNum, option.strataNum, rng);
+
+    std::vector<char> failVec(sampleVec.size(), 0);
+
+    parallelFor(sampleVec.size(), [&](int, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            failVec[i] = isTriFailing(sampleVec[i]);
+    });
+
+    result.sampleNum = sampleVec.size();
+
+    // Escalate to a full check around every failure
+    std::vector<char> visited;
+    for (size_t i = 0; i < sampleVec.size(); ++i)
+    {
+        if (!failVec[i])
+            continue;
+
+        ++result.failNum;
+        if (visited.empty())
+            visited.assign(triNum, 0);
+        checkNeighbourhood(sampleVec[i], option.neighbourhoodSize, visited, result);
+    }
+
+    if (result.sampleNum > 0)
+    {
+        result.failRate = (double)result.failNum / result.sampleNum;
+        if (result.failNum == 0)
+            result.failRateBound = 1.0 - std::pow(1.0 - option.confidence, 1.0 / result.sampleNum);
+    }
+
+    // Stratified sample of constraints, drawn like the triangles. Finding
+    // their edges still takes one streaming pass over all triangles, so this
+    // part costs O(triNum), though no predicate is evaluated.
+    const long long conSampleNum = std::min<long long>(conNum, (long long)std::min<double>(needed, (double)conNum));
+    if (conSampleNum > 0)
+    {
+        std::unordered_set<Edge, EdgeHash, EdgeEqual> conSet;
+        std::vector<char>                             vertMark(predWrapper.pointNum(), 0);
+
+        for (const int ci : stratifiedSample(conNum, conSampleNum, option.strataNum, rng))
+        {
+            const Edge con = consArr[ci];
+            if (!conSet.insert(con).second)
+                continue;
+            vertMark[con._v[0]] = 1;
+            vertMark[con._v[1]] = 1;
         }
-        else
+
+        std::unordered_set<Edge, EdgeHash, EdgeEqual> foundSet;
+        for (long long ti = 0; ti < triNum; ++ti)
         {
-            if (j >= MaxWalking)
-                std::cout << "Vertex degree too high; Skipping constraint " << i << std::endl;
-            ++failNum;
+            const Tri &tri = triArr[ti];
+            if (!vertMark[tri._v[0]] && !vertMark[tri._v[1]] && !vertMark[tri._v[2]])
+                continue;
+
+            for (const auto &seg : TriSeg)
+            {
+                const Edge edge = {tri._v[seg[0]], tri._v[seg[1]]};
+                if (conSet.count(edge))
+                    foundSet.insert(edge);
+            }
         }
+
+        result.conSampleNum = conSet.size();
+        result.conFailNum   = conSet.size() - foundSet.size();
     }
 
-    std::cout << "\nConstraint check: ";
+    timer.stop();
 
-    if (failNum == 0)
-        std::cout << "Pass" << std::endl;
+    std::cout << "\nSampled check: ";
+    if (result.failNum == 0 && result.conFailNum == 0)
+        std::cout << "Pass";
+    else
+        std::cout << "***Fail***";
+    std::cout << " (" << timer.value() << " ms)" << std::endl;
+    std::cout << "  Sampled triangles: " << result.sampleNum << " Failed: " << result.failNum << std::endl;
+    if (result.failNum == 0)
+        std::cout << "  Failure rate below " << result.failRateBound << " with confidence " << option.confidence
+                  << std::endl;
     else
-        std::cout << "***Fail*** Missing constraints: " << failNum << std::endl;
+        std::cout << "  Estimated failure rate: " << result.failRate << " Neighbourhood failures: "
+                  << result.escalatedFailNum << " / " << result.escalatedNum << std::endl;
+    if (result.conSampleNum > 0)
+        std::cout << "  Sampled constraints: " << result.conSampleNum << " Missing: " << result.conFailNum
+                  << std::endl;
+
+    return result;
+}
 }
-}
\ No newline at end of file
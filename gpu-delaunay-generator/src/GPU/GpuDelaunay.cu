@@ -63,6 +63,7 @@ void GpuDel::compute(const Input &input, Output &output)
 {
     inputPtr  = &input;
     outputPtr = &output;
+    output.reset();
 
     initProfiling();
 #if PROFILE_LEVEL >= PROFILE_NONE
@@ -92,6 +93,20 @@ void GpuDel::compute(const Input &input, Output &output)
               << ", " << stats.outTime << ")" << std::endl;
     ++i;
 #endif
+    dPredWrapper.cleanup();
+    if (!keepBuffers)
+    {
+        cleanup();
+    }
+}
+
+void GpuDel::setKeepBuffers(bool keep)
+{
+    keepBuffers = keep;
+}
+
+void GpuDel::releaseBuffers()
+{
     cleanup();
 }
 
@@ -135,10 +150,10 @@ void GpuDel::initForFlip()
 
 void GpuDel::initSizeAndBuffers()
 {
-    pointNum = static_cast<int>(inputPtr->pointVec.size()) + 1; // Plus the infinity point
+    pointNum = static_cast<int>(inputPtr->pointNum()) + 1; // Plus the infinity point
     pointVec.resize(pointNum);
-    pointVec.copyFromHost(inputPtr->pointVec);
-    constraintVec.copyFromHost(inputPtr->constraintVec);
+    pointVec.copyFromHost(inputPtr->points(), inputPtr->pointNum());
+    constraintVec.copyFromHost(inputPtr->constraints(), inputPtr->constraintNum());
     actConsVec.resize(constraintVec.size());
 
     triMaxNum = pointNum * 2;
@@ -157,6 +172,14 @@ void GpuDel::initSizeAndBuffers()
     rejFlipVec.resize(triMaxNum);
 #endif
 
+    // Kept buffers are reused if they are large enough
+    const bool hasCons = constraintVec.size() > 0;
+    if (poolTriMaxNum >= triMaxNum && (poolHasCons || !hasCons))
+    {
+        return;
+    }
+    memPool.free();
+
     // Preallocate some buffers in the pool
     memPool.reserve<FlipItem>(triMaxNum); // flipVec
     memPool.reserve<int2>(triMaxNum);     // triMsgVec
@@ -165,10 +188,12 @@ void GpuDel::initSizeAndBuffers()
     memPool.reserve<int>(triMaxNum);      // Two more for common use
     memPool.reserve<int>(triMaxNum);      //
 
-    if (constraintVec.size() > 0)
+    if (hasCons)
     {
         memPool.reserve<int>(triMaxNum);
     }
+    poolTriMaxNum = triMaxNum;
+    poolHasCons   = hasCons;
 }
 
 void GpuDel::findMinMax()
@@ -1193,6 +1218,8 @@ void GpuDel::cleanup()
     thrust_free_all();
 
     memPool.free();
+    poolTriMaxNum = 0;
+    poolHasCons   = false;
 
     pointVec.free();
     constraintVec.free();
@@ -0,0 +1,103 @@
+#include "../include/GeojsonFile.h"
+#include "../include/ParallelWriter.h"
+#include <cmath>
+#include <cstdio>
+
+namespace gdg
+{
+namespace
+{
+constexpr size_t MaxPositionChars = 3 + 3 * (MaxDoubleChars + 1);
+constexpr size_t MaxFeatureChars  = 160 + 3 * (MaxIntChars + 8) + 4 * (MaxPositionChars + 1);
+
+std::string escapeJson(const std::string &str)
+{
+    std::string escaped;
+    for (const char c : str)
+    {
+        if (c == '"' || c == '\\')
+        {
+            escaped += '\\';
+            escaped += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", c);
+            escaped += code;
+        }
+        else
+        {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+bool isFinite(const Point &pt)
+{
+    return std::isfinite(pt._p[0]) && std::isfinite(pt._p[1]) && std::isfinite(pt._p[2]);
+}
+
+char *writePosition(char *ptr, const Point &pt)
+{
+    *ptr++ = '[';
+    ptr    = writeDouble(ptr, pt._p[0]);
+    *ptr++ = ',';
+    ptr    = writeDouble(ptr, pt._p[1]);
+    *ptr++ = ',';
+    ptr    = writeDouble(ptr, pt._p[2]);
+    *ptr++ = ']';
+    return ptr;
+}
+}
+
+void writeGeojson(std::ostream        &out,
+                  const Point         *pointArr,
+                  const Tri           *triArr,
+                  size_t               triNum,
+                  const GeojsonOption &option)
+{
+    // JSON has no literal for nan or inf, so check before anything is written
+    const size_t badNum = parallelSum<size_t>(triNum, [&](size_t begin, size_t end) {
+        size_t num = 0;
+        for (size_t i = begin; i < end; ++i)
+            for (int j = 0; j < 3; ++j)
+                num += !isFinite(pointArr[triArr[i]._v[j]]);
+        return num;
+    });
+    if (badNum > 0)
+    {
+        throw std::invalid_argument("GeojsonFile: cannot write non-finite coordinates");
+    }
+
+    out << "{\"type\":\"FeatureCollection\",\"name\":\"" << escapeJson(option.name) << "\",";
+    if (!option.crs.empty())
+    {
+        out << "\"crs\":{\"type\":\"name\",\"properties\":{\"name\":\"" << escapeJson(option.crs) << "\"}},";
+    }
+    out << "\"features\":[\n";
+
+    // The ring is closed by repeating the first vertex, as GeoJSON requires
+    writeParallel(out, triNum, MaxFeatureChars, [&](size_t i, char *ptr) {
+        const Tri &tri = triArr[i];
+        ptr            = writeStr(ptr, "{\"type\":\"Feature\",\"properties\":{\"v0\":");
+        ptr            = writeInt(ptr, tri._v[0]);
+        ptr            = writeStr(ptr, ",\"v1\":");
+        ptr            = writeInt(ptr, tri._v[1]);
+        ptr            = writeStr(ptr, ",\"v2\":");
+        ptr            = writeInt(ptr, tri._v[2]);
+        ptr            = writeStr(ptr, "},\"geometry\":{\"type\":\"Polygon\",\"coordinates\":[[");
+        for (int j = 0; j < 4; ++j)
+        {
+            if (j > 0)
+                *ptr++ = ',';
+            ptr = writePosition(ptr, pointArr[tri._v[j % 3]]);
+        }
+        ptr = writeStr(ptr, (i + 1 < triNum) ? "]]}},\n" : "]]}}\n");
+        return ptr;
+    });
+
+    out << "]}" << std::endl;
+}
+}
@@ -0,0 +1,201 @@
+#include "../include/GlbFile.h"
+#include "../include/HostParallel.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace gdg
+{
+namespace
+{
+constexpr uint32_t GlbMagic     = 0x46546C67; // "glTF"
+constexpr uint32_t GlbVersion   = 2;
+constexpr uint32_t GlbChunkJson = 0x4E4F534A; // "JSON"
+constexpr uint32_t GlbChunkBin  = 0x004E4942; // "BIN\0"
+
+// glTF accessor component types and buffer view targets
+constexpr int GltfUInt8        = 5121;
+constexpr int GltfUInt16       = 5123;
+constexpr int GltfUInt32       = 5125;
+constexpr int GltfFloat        = 5126;
+constexpr int GltfArrayBuffer  = 34962;
+constexpr int GltfElementArray = 34963;
+
+constexpr double QuantizeMax = 65535.0;
+
+size_t padTo4(size_t size)
+{
+    return (size + 3) & ~size_t(3);
+}
+
+void writeU32(std::ostream &out, uint32_t val)
+{
+    out.write(reinterpret_cast<const char *>(&val), sizeof(val));
+}
+
+// Index values must stay below the largest value of the component type,
+// which glTF reserves
+int indexComponentType(size_t pointNum, size_t &indexSize)
+{
+    if (pointNum <= UINT8_MAX)
+    {
+        indexSize = 1;
+        return GltfUInt8;
+    }
+    if (pointNum <= UINT16_MAX)
+    {
+        indexSize = 2;
+        return GltfUInt16;
+    }
+    indexSize = 4;
+    return GltfUInt32;
+}
+
+template <typename T>
+void packIndices(char *dst, const Tri *triArr, size_t triNum)
+{
+    parallelFor(triNum, [&](int, size_t begin, size_t end) {
+        T *ptr = reinterpret_cast<T *>(dst) + begin * 3;
+        for (size_t i = begin; i < end; ++i)
+            for (int v : triArr[i]._v)
+                *ptr++ = static_cast<T>(v);
+    });
+}
+}
+
+void writeGlb(std::ostream    &out,
+              const Point     *pointArr,
+              size_t           pointNum,
+              const Tri       *triArr,
+              size_t           triNum,
+              const GlbOption &option)
+{
+    // glTF forbids zero-length buffers and accessors with no elements
+    if (pointNum == 0 || triNum == 0)
+    {
+        throw std::invalid_argument("GlbFile: cannot write an empty mesh");
+    }
+
+    double minVal[3], maxVal[3];
+    for (int j = 0; j < 3; ++j)
+        minVal[j] = maxVal[j] = pointArr[0]._p[j];
+    for (size_t i = 1; i < pointNum; ++i)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            minVal[j] = std::min(minVal[j], pointArr[i]._p[j]);
+            maxVal[j] = std::max(maxVal[j], pointArr[i]._p[j]);
+        }
+    }
+
+    double extent[3];
+    for (int j = 0; j < 3; ++j)
+        extent[j] = (maxVal[j] > minVal[j]) ? maxVal[j] - minVal[j] : 1.0;
+
+    // uint16 vec3 elements are padded to 8 bytes to keep 4-byte alignment
+    const size_t posStride    = option.quantize ? 4 * sizeof(uint16_t) : 3 * sizeof(float);
+    const size_t posSize      = pointNum * posStride;
+    size_t       indexSize    = 0;
+    const int    indexType    = indexComponentType(pointNum, indexSize);
+    const size_t indexOffset  = padTo4(posSize);
+    const size_t indexByteNum = triNum * 3 * indexSize;
+    const size_t binSize      = padTo4(indexOffset + indexByteNum);
+
+    std::vector<char> bin(binSize, 0);
+
+    parallelFor(pointNum, [&](int, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            char *dst = bin.data() + i * posStride;
+            for (int j = 0; j < 3; ++j)
+            {
+                const double rel = pointArr[i]._p[j] - minVal[j];
+                if (option.quantize)
+                {
+                    const auto q = static_cast<uint16_t>(std::lround(rel / extent[j] * QuantizeMax));
+                    std::memcpy(dst + j * sizeof(uint16_t), &q, sizeof(q));
+                }
+                else
+                {
+                    const auto f = static_cast<float>(rel);
+                    std::memcpy(dst + j * sizeof(float), &f, sizeof(f));
+                }
+            }
+        }
+    });
+
+    char *indexDst = bin.data() + indexOffset;
+    if (indexSize == 1)
+        packIndices<uint8_t>(indexDst, triArr, triNum);
+    else if (indexSize == 2)
+        packIndices<uint16_t>(indexDst, triArr, triNum);
+    else
+        packIndices<uint32_t>(indexDst, triArr, triNum);
+
+    std::ostringstream json;
+    json << std::setprecision(17);
+    json << "{\"asset\":{\"version\":\"2.0\",\"generator\":\"gpu-delaunay-generator\"},";
+    if (option.quantize)
+    {
+        json << "\"extensionsUsed\":[\"KHR_mesh_quantization\"],"
+             << "\"extensionsRequired\":[\"KHR_mesh_quantization\"],";
+    }
+    json << "\"scene\":0,\"scenes\":[{\"nodes\":[0]}],";
+    json << "\"nodes\":[{\"mesh\":0,\"translation\":[" << minVal[0] << "," << minVal[1] << "," << minVal[2] << "]";
+    if (option.quantize)
+    {
+        json << ",\"scale\":[" << extent[0] / QuantizeMax << "," << extent[1] / QuantizeMax << ","
+             << extent[2] / QuantizeMax << "]";
+    }
+    json << "}],";
+    json << "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0},\"indices\":1,\"mode\":4}]}],";
+    json << "\"buffers\":[{\"byteLength\":" << binSize << "}],";
+    json << "\"bufferViews\":[";
+    json << "{\"buffer\":0,\"byteOffset\":0,\"byteLength\":" << posSize << ",\"byteStride\":" << posStride
+         << ",\"target\":" << GltfArrayBuffer << "},";
+    json << "{\"buffer\":0,\"byteOffset\":" << indexOffset << ",\"byteLength\":" << indexByteNum
+         << ",\"target\":" << GltfElementArray << "}],";
+    json << "\"accessors\":[";
+    json << "{\"bufferView\":0,\"count\":" << pointNum << ",\"type\":\"VEC3\",";
+    if (option.quantize)
+    {
+        json << "\"componentType\":" << GltfUInt16 << ",\"min\":[0,0,0],\"max\":[";
+        for (int j = 0; j < 3; ++j)
+            json << (j ? "," : "") << ((maxVal[j] > minVal[j]) ? QuantizeMax : 0);
+        json << "]},";
+    }
+    else
+    {
+        json << "\"componentType\":" << GltfFloat << ",\"min\":[0,0,0],\"max\":[";
+        for (int j = 0; j < 3; ++j)
+            json << (j ? "," : "") << static_cast<float>(maxVal[j] - minVal[j]);
+        json << "]},";
+    }
+    json << "{\"bufferView\":1,\"count\":" << triNum * 3 << ",\"type\":\"SCALAR\",\"componentType\":" << indexType
+         << "}]}";
+
+    std::string jsonStr = json.str();
+    jsonStr.resize(padTo4(jsonStr.size()), ' ');
+
+    const size_t totalSize = 12 + 8 + jsonStr.size() + 8 + binSize;
+    if (totalSize > UINT32_MAX)
+    {
+        throw std::runtime_error("GlbFile: mesh too large for a single .glb file");
+    }
+
+    writeU32(out, GlbMagic);
+    writeU32(out, GlbVersion);
+    writeU32(out, static_cast<uint32_t>(totalSize));
+    writeU32(out, static_cast<uint32_t>(jsonStr.size()));
+    writeU32(out, GlbChunkJson);
+    out.write(jsonStr.data(), static_cast<std::streamsize>(jsonStr.size()));
+    writeU32(out, static_cast<uint32_t>(binSize));
+    writeU32(out, GlbChunkBin);
+    out.write(bin.data(), static_cast<std::streamsize>(binSize));
+
+    if (!out)
+    {
+        throw std::runtime_error("GlbFile: failed writing .glb data");
+    }
+}
+}
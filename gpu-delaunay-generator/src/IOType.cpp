@@ -1,45 +1,369 @@
 #include "../include/IOType.h"
 #include "../include/HashFunctors.h"
+#include "../include/HostParallel.h"
+#include "../include/PointFile.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <unordered_set>
 
 namespace gdg
 {
-void Input::removeDuplicates()
+namespace
 {
-    Point2DHVec oldPointVec      = std::move(pointVec);
-    EdgeHVec    oldConstraintVec = std::move(constraintVec);
+// Points are bucketed on a grid with cells of the equality tolerance, so
+// points equal under Point::operator== lie in the same or adjacent cells
+struct PointCell
+{
+    uint64_t c[2];
+
+    bool operator==(const PointCell &other) const
+    {
+        return c[0] == other.c[0] && c[1] == other.c[1];
+    }
+};
+
+uint64_t cellCoord(double val)
+{
+    const double cell = std::floor(val / PointEqualTolerance);
+    if (std::abs(cell) < 0x1p62)
+        return static_cast<uint64_t>(static_cast<int64_t>(cell));
+
+    // Beyond this the spacing of doubles exceeds the tolerance, so only
+    // equal values are equal points and the bits serve as the cell
+    uint64_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    return bits;
+}
+
+PointCell pointCell(const Point &pt)
+{
+    return {{cellCoord(pt._p[0]), cellCoord(pt._p[1])}};
+}
+
+uint64_t hashCell(const PointCell &cell)
+{
+    uint64_t h = cell.c[0] * 0x9e3779b97f4a7c15ULL;
+    h          = (h ^ (h >> 29) ^ cell.c[1]) * 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 32;
+    h *= 0xd6e8feb86659fd93ULL;
+    h ^= h >> 32;
+    return h;
+}
+
+// Open-addressing table from a cell to the points in it, linked in index
+// order through next[]. The points are split into shards by cell hash and
+// each shard has its own table, built by one thread.
+class PointGrid
+{
+  private:
+    struct Slot
+    {
+        PointCell cell;
+        int       head = -1; // -1 if the slot is empty
+    };
+
+    const Point                   *points;
+    int                            shardNum;
+    std::vector<PointCell>         cells;
+    std::vector<uint64_t>          hashes;
+    std::vector<int>               next;
+    std::vector<std::vector<Slot>> tables;
+
+    int shardOf(uint64_t hash) const
+    {
+        return static_cast<int>(((hash >> 32) * shardNum) >> 32);
+    }
+
+    int head(const PointCell &cell, uint64_t hash) const
+    {
+        const std::vector<Slot> &table = tables[shardOf(hash)];
+        const size_t             mask  = table.size() - 1;
+        for (size_t slot = hash & mask;; slot = (slot + 1) & mask)
+        {
+            if (table[slot].head < 0 || table[slot].cell == cell)
+                return table[slot].head;
+        }
+    }
+
+  public:
+    PointGrid(const Point *points, size_t num)
+        : points(points), shardNum(parallelThreadNum(num)), cells(num), hashes(num), next(num, -1), tables(shardNum)
+    {
+        // Count the points of each shard per thread, then list them by shard,
+        // keeping the index order within a shard
+        std::vector<size_t> shardOffset(size_t(shardNum) * shardNum + 1, 0); // [shard][thread]
+
+        parallelFor(num, [&](int t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                cells[i]  = pointCell(points[i]);
+                hashes[i] = hashCell(cells[i]);
+                ++shardOffset[size_t(shardOf(hashes[i])) * shardNum + t + 1];
+            }
+        });
+        for (size_t i = 1; i < shardOffset.size(); ++i)
+            shardOffset[i] += shardOffset[i - 1];
+
+        std::vector<int> shardIdx(num);
+        parallelFor(num, [&](int t, size_t begin, size_t end) {
+            std::vector<size_t> pos(shardNum);
+            for (int s = 0; s < shardNum; ++s)
+                pos[s] = shardOffset[size_t(s) * shardNum + t];
+            for (size_t i = begin; i < end; ++i)
+                shardIdx[pos[shardOf(hashes[i])]++] = static_cast<int>(i);
+        });
+
+        // One thread builds the table of each shard
+        parallelInvoke(shardNum, [&](int s) {
+            const size_t first = shardOffset[size_t(s) * shardNum];
+            const size_t last  = shardOffset[size_t(s + 1) * shardNum];
+
+            size_t capacity = 16;
+            while (capacity < 2 * (last - first))
+                capacity *= 2;
+            std::vector<Slot> &table = tables[s];
+            table.resize(capacity);
+
+            // Inserted backwards so each list runs in index order
+            for (size_t k = last; k-- > first;)
+            {
+                const int i = shardIdx[k];
+                for (size_t slot = hashes[i] & (capacity - 1);; slot = (slot + 1) & (capacity - 1))
+                {
+                    if (table[slot].head < 0)
+                    {
+                        table[slot].cell = cells[i];
+                        table[slot].head = i;
+                        break;
+                    }
+                    if (table[slot].cell == cells[i])
+                    {
+                        next[i]          = table[slot].head;
+                        table[slot].head = i;
+                        break;
+                    }
+                }
+            }
+        });
+    }
+
+    // Call func(j) on the points j < i equal to point i until it returns false
+    template <typename Func>
+    void forEachEarlierEqual(int i, Func func) const
+    {
+        for (int dx = -1; dx <= 1; ++dx)
+        {
+            for (int dy = -1; dy <= 1; ++dy)
+            {
+                const PointCell cell = {{cells[i].c[0] + uint64_t(dx), cells[i].c[1] + uint64_t(dy)}};
+                for (int j = head(cell, hashCell(cell)); j >= 0 && j < i; j = next[j])
+                {
+                    if (points[j] == points[i] && !func(j))
+                        return;
+                }
+            }
+        }
+    }
+};
+}
+
+const Point *Input::points() const
+{
+    return mappedPointArr ? mappedPointArr : pointVec.data();
+}
+
+size_t Input::pointNum() const
+{
+    return mappedPointArr ? mappedPointNum : pointVec.size();
+}
+
+const Edge *Input::constraints() const
+{
+    return mappedConstraintArr ? mappedConstraintArr : constraintVec.data();
+}
+
+size_t Input::constraintNum() const
+{
+    return mappedConstraintArr ? mappedConstraintNum : constraintVec.size();
+}
+
+bool Input::isMapped() const
+{
+    return mappedFile != nullptr;
+}
+
+void Input::mapFromFile(const std::string &filename, bool withConstraints)
+{
+    auto file = std::make_shared<const MappedFile>(filename);
 
-    std::unordered_set<Point, PointHash> pointSet;
-    std::vector<int>                     pointMap(oldPointVec.size());
-    for (std::size_t i = 0; i < oldPointVec.size(); ++i)
+    const PointFileHeader &header = checkPointFileHeader(file->data(), file->size());
+
+    unmap();
+    Point2DHVec().swap(pointVec);
+    mappedPointArr = reinterpret_cast<const Point *>(file->data() + header.pointOffset);
+    mappedPointNum = header.pointNum;
+
+    if (withConstraints)
     {
-        const auto &pt = oldPointVec[i];
-        if (pointSet.find(pt) == pointSet.end())
+        EdgeHVec().swap(constraintVec);
+        mappedConstraintArr = reinterpret_cast<const Edge *>(file->data() + header.constraintOffset);
+        mappedConstraintNum = header.constraintNum;
+    }
+
+    mappedFile = std::move(file);
+}
+
+void Input::unmap()
+{
+    if (!mappedFile)
+        return;
+
+    if (mappedPointArr)
+        pointVec.assign(mappedPointArr, mappedPointArr + mappedPointNum);
+    if (mappedConstraintArr)
+        constraintVec.assign(mappedConstraintArr, mappedConstraintArr + mappedConstraintNum);
+
+    mappedFile.reset();
+    mappedPointArr      = nullptr;
+    mappedPointNum      = 0;
+    mappedConstraintArr = nullptr;
+    mappedConstraintNum = 0;
+}
+
+size_t Input::removeDuplicates()
+{
+    unmap();
+
+    const size_t    num = pointVec.size();
+    const PointGrid grid(pointVec.data(), num);
+    const int       threadNum = parallelThreadNum(num);
+
+    // firstIdx[i] is the kept point that point i merges into, itself if kept.
+    // A point with no earlier equal point is kept.
+    std::vector<int>              firstIdx(num);
+    std::vector<std::vector<int>> candidates(threadNum);
+    parallelFor(num, [&](int t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
         {
-            pointSet.insert(pt);
-            pointVec.push_back(pt);
+            bool hasEqual = false;
+            grid.forEachEarlierEqual(static_cast<int>(i), [&](int) {
+                hasEqual = true;
+                return false;
+            });
+            firstIdx[i] = static_cast<int>(i);
+            if (hasEqual)
+                candidates[t].push_back(static_cast<int>(i));
         }
-        else
+    });
+
+    // Equality within a tolerance is not transitive, so the others are settled
+    // in index order: a point is removed if it equals an earlier kept point,
+    // and merges into the first such point
+    for (const std::vector<int> &threadCandidates : candidates)
+    {
+        for (const int i : threadCandidates)
         {
-            std::cout << " Duplicate point found at [" << i << "], will remove from indexing!" << std::endl;
+            grid.forEachEarlierEqual(i, [&](int j) {
+                if (firstIdx[j] == j)
+                    firstIdx[i] = std::min(firstIdx[i], j);
+                return true;
+            });
         }
-        pointMap[i] = static_cast<int>(pointVec.size()) - 1;
     }
 
+    // Compact the kept points in index order
+    std::vector<size_t> keptOffset(threadNum + 1, 0);
+    parallelFor(num, [&](int t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            keptOffset[t + 1] += (firstIdx[i] == static_cast<int>(i));
+    });
+    for (int t = 0; t < threadNum; ++t)
+        keptOffset[t + 1] += keptOffset[t];
+
+    const size_t     keptNum = keptOffset[threadNum];
+    Point2DHVec      oldPointVec(keptNum);
+    std::vector<int> newIdx(num);
+    oldPointVec.swap(pointVec);
+
+    parallelFor(num, [&](int t, size_t begin, size_t end) {
+        size_t pos = keptOffset[t];
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (firstIdx[i] == static_cast<int>(i))
+            {
+                newIdx[i]     = static_cast<int>(pos);
+                pointVec[pos] = oldPointVec[i];
+                ++pos;
+            }
+        }
+    });
+
+    const size_t removedNum = num - keptNum;
+    if (removedNum == 0)
+        return 0;
+
+    std::cout << " Removed " << removedNum << " duplicate points" << std::endl;
+
+    // A duplicate takes the index of the first point equal to it
+    EdgeHVec oldConstraintVec = std::move(constraintVec);
+    constraintVec.clear();
+
     std::unordered_set<Edge, EdgeHash, EdgeEqual> edgeSet;
     for (auto &con : oldConstraintVec)
     {
-        Edge edge = {pointMap[con._v[0]], pointMap[con._v[1]]};
+        Edge edge = {newIdx[firstIdx[con._v[0]]], newIdx[firstIdx[con._v[1]]]};
         if (edge._v[0] != edge._v[1] && edgeSet.find(edge) == edgeSet.end())
         {
             edgeSet.insert(edge);
             constraintVec.push_back(edge);
         }
     }
+
+    return removedNum;
+}
+
+const Tri *Output::tris() const
+{
+    return mappedTriArr ? mappedTriArr : triVec.data();
+}
+
+const TriOpp *Output::triOpps() const
+{
+    return mappedTriArr ? mappedTriOppArr : triOppVec.data();
+}
+
+size_t Output::triNum() const
+{
+    return mappedTriArr ? mappedTriNum : triVec.size();
+}
+
+bool Output::isMapped() const
+{
+    return mappedFile != nullptr;
+}
+
+void Output::unmap()
+{
+    if (!mappedFile)
+        return;
+
+    triVec.assign(mappedTriArr, mappedTriArr + mappedTriNum);
+    triOppVec.assign(mappedTriOppArr, mappedTriOppArr + mappedTriNum);
+
+    mappedFile.reset();
+    mappedTriArr    = nullptr;
+    mappedTriOppArr = nullptr;
+    mappedTriNum    = 0;
 }
 
 void Output::reset()
 {
+    mappedFile.reset();
+    mappedTriArr    = nullptr;
+    mappedTriOppArr = nullptr;
+    mappedTriNum    = 0;
+
     triVec.clear();
     triOppVec.clear();
     edgeSet.clear();
@@ -48,8 +372,9 @@ void Output::reset()
 
 void Output::getEdgesFromTriVec()
 {
-    for (auto &tri : triVec)
+    for (size_t i = 0; i < triNum(); ++i)
     {
+        const Tri &tri = tris()[i];
         edgeSet.insert({tri._v[0], tri._v[1]});
         edgeSet.insert({tri._v[0], tri._v[2]});
         edgeSet.insert({tri._v[1], tri._v[2]});
@@ -0,0 +1,168 @@
+#include "../include/LasReader.h"
+#include <cstring>
+
+namespace gdg
+{
+namespace
+{
+constexpr size_t LasHeaderSize10 = 227; // LAS 1.0-1.2
+constexpr size_t LasHeaderSize14 = 375;
+
+// Shortest record of each point data format
+constexpr int LasMinRecordLength[] = {20, 28, 26, 34, 57, 63, 30, 36, 38, 59, 67};
+
+template <typename T>
+T readLE(const char *data, size_t offset)
+{
+    T val;
+    std::memcpy(&val, data + offset, sizeof(T));
+    return val;
+}
+}
+
+LasReader::LasReader(const std::string &filename, const LasFilter &filter) : file(filename)
+{
+    readHeader();
+
+    for (int c : filter.classifications)
+    {
+        if (c < 0 || c > 255)
+        {
+            throw std::invalid_argument("LasReader: classification " + std::to_string(c) + " out of range");
+        }
+        classMask.set(c);
+    }
+    if (classMask.none())
+        classMask.set();
+
+    for (int r : filter.returnNumbers)
+    {
+        if (r < 0 || r > 15)
+        {
+            throw std::invalid_argument("LasReader: return number " + std::to_string(r) + " out of range");
+        }
+        returnMask.set(r);
+    }
+    if (returnMask.none())
+        returnMask.set();
+
+    lastReturnOnly = filter.lastReturnOnly;
+}
+
+void LasReader::readHeader()
+{
+    const char  *data = file.data();
+    const size_t size = file.size();
+
+    if (size < LasHeaderSize10 || std::memcmp(data, "LASF", 4) != 0)
+    {
+        throw std::runtime_error("LasReader: not a LAS file");
+    }
+
+    _header.versionMajor = readLE<uint8_t>(data, 24);
+    _header.versionMinor = readLE<uint8_t>(data, 25);
+    if (_header.versionMajor != 1 || _header.versionMinor > 4)
+    {
+        throw std::runtime_error("LasReader: unsupported LAS version " + std::to_string(_header.versionMajor) + "." +
+                                 std::to_string(_header.versionMinor));
+    }
+
+    const auto headerSize = readLE<uint16_t>(data, 94);
+    const auto formatByte = readLE<uint8_t>(data, 104);
+    // The two top bits mark LASzip compressed data
+    if ((formatByte & 0xC0) != 0)
+    {
+        throw std::runtime_error("LasReader: compressed (LAZ) files are not supported");
+    }
+
+    _header.pointFormat  = formatByte;
+    _header.recordLength = readLE<uint16_t>(data, 105);
+    _header.pointOffset  = readLE<uint32_t>(data, 96);
+    _header.pointNum     = readLE<uint32_t>(data, 107);
+    if (_header.versionMinor >= 4 && headerSize >= LasHeaderSize14 && size >= LasHeaderSize14)
+    {
+        // 1.4 files keep the legacy count at zero when it does not fit 32 bits
+        const auto pointNum = readLE<uint64_t>(data, 247);
+        if (pointNum != 0)
+            _header.pointNum = pointNum;
+    }
+
+    for (int i = 0; i < 3; ++i)
+    {
+        _header.scale[i]  = readLE<double>(data, 131 + 8 * i);
+        _header.offset[i] = readLE<double>(data, 155 + 8 * i);
+        _header.maxVal[i] = readLE<double>(data, 179 + 16 * i);
+        _header.minVal[i] = readLE<double>(data, 187 + 16 * i);
+    }
+
+    if (_header.pointFormat > 10)
+    {
+        throw std::runtime_error("LasReader: unsupported point data format " + std::to_string(_header.pointFormat));
+    }
+    if (_header.recordLength < LasMinRecordLength[_header.pointFormat])
+    {
+        throw std::runtime_error("LasReader: point record too short for format " +
+                                 std::to_string(_header.pointFormat));
+    }
+    if (_header.pointOffset < headerSize || _header.pointOffset > size ||
+        _header.pointNum > (size - _header.pointOffset) / _header.recordLength)
+    {
+        throw std::runtime_error("LasReader: truncated or corrupted file");
+    }
+}
+
+const LasHeader &LasReader::header() const
+{
+    return _header;
+}
+
+uint64_t LasReader::readChunk(uint64_t first, size_t chunkSize, Point2DHVec &chunk) const
+{
+    chunk.resize(chunkSize);
+
+    const char  *data     = file.data() + _header.pointOffset;
+    const size_t length   = _header.recordLength;
+    const bool   extended = _header.pointFormat >= 6;
+
+    size_t   num    = 0;
+    uint64_t record = first;
+    for (; record < _header.pointNum && num < chunkSize; ++record)
+    {
+        const char *rec = data + record * length;
+
+        // Formats 0-5 pack return number and count in 3 bits each and keep a
+        // 5-bit class; formats 6-10 use 4 bits each and a full byte class
+        const auto returnByte = readLE<uint8_t>(rec, 14);
+        int        returnNum, returnCount, classification;
+        if (extended)
+        {
+            returnNum      = returnByte & 0x0F;
+            returnCount    = returnByte >> 4;
+            classification = readLE<uint8_t>(rec, 16);
+        }
+        else
+        {
+            returnNum      = returnByte & 0x07;
+            returnCount    = (returnByte >> 3) & 0x07;
+            classification = readLE<uint8_t>(rec, 15) & 0x1F;
+        }
+
+        if (!classMask[classification] || !returnMask[returnNum] || (lastReturnOnly && returnNum != returnCount))
+            continue;
+
+        Point &pt = chunk[num++];
+        for (int i = 0; i < 3; ++i)
+            pt._p[i] = readLE<int32_t>(rec, 4 * i) * _header.scale[i] + _header.offset[i];
+    }
+
+    chunk.resize(num);
+    return record;
+}
+
+void LasReader::read(Point2DHVec &pointVec, size_t chunkSize) const
+{
+    pointVec.reserve(pointVec.size() + _header.pointNum);
+    forEachChunk(chunkSize,
+                 [&](const Point2DHVec &chunk) { pointVec.insert(pointVec.end(), chunk.begin(), chunk.end()); });
+}
+}
@@ -0,0 +1,58 @@
+#include "../include/MappedFile.h"
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace gdg
+{
+MappedFile::MappedFile(const std::string &filename)
+{
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        throw std::runtime_error("MappedFile: cannot open " + filename);
+    }
+
+    struct stat st
+    {
+    };
+    if (fstat(fd, &st) == -1)
+    {
+        close(fd);
+        throw std::runtime_error("MappedFile: cannot stat " + filename);
+    }
+
+    _size = static_cast<size_t>(st.st_size);
+    if (_size > 0)
+    {
+        void *addr = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED)
+        {
+            close(fd);
+            throw std::runtime_error("MappedFile: cannot map " + filename);
+        }
+        // The file is read front to back
+        madvise(addr, _size, MADV_SEQUENTIAL);
+        _data = static_cast<const char *>(addr);
+    }
+    close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (_data != nullptr)
+        munmap(const_cast<char *>(_data), _size);
+}
+
+const char *MappedFile::data() const
+{
+    return _data;
+}
+
+size_t MappedFile::size() const
+{
+    return _size;
+}
+}
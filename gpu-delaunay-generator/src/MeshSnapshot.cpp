@@ -0,0 +1,118 @@
+#include "../include/MeshSnapshot.h"
+#include <cstring>
+
+namespace gdg
+{
+namespace
+{
+uint64_t alignUp(uint64_t offset)
+{
+    return (offset + MeshSnapshotAlign - 1) / MeshSnapshotAlign * MeshSnapshotAlign;
+}
+
+void writeBlock(std::ofstream &outFile, uint64_t &pos, uint64_t offset, const void *data, uint64_t size)
+{
+    const char zeros[MeshSnapshotAlign] = {};
+    outFile.write(zeros, static_cast<std::streamsize>(offset - pos));
+    outFile.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+    pos = offset + size;
+}
+
+bool isArrayInFile(uint64_t offset, uint64_t num, uint64_t elemSize, size_t size)
+{
+    return offset % MeshSnapshotAlign == 0 && offset <= size && num <= (size - offset) / elemSize;
+}
+}
+
+bool isMeshSnapshot(const std::string &filename)
+{
+    std::ifstream inFile(filename, std::ios::binary);
+    char          magic[4] = {};
+    inFile.read(magic, sizeof(magic));
+    return inFile && std::memcmp(magic, MeshSnapshotMagic, sizeof(magic)) == 0;
+}
+
+void saveMeshSnapshot(const std::string &filename, const Input &input, const Output &output)
+{
+    std::ofstream outFile(filename, std::ios::binary);
+    if (!outFile.is_open())
+    {
+        throw std::runtime_error("MeshSnapshot: cannot write " + filename);
+    }
+
+    MeshSnapshotHeader header{};
+    std::memcpy(header.magic, MeshSnapshotMagic, sizeof(header.magic));
+    header.version          = MeshSnapshotVersion;
+    header.pointNum         = input.pointNum();
+    header.constraintNum    = input.constraintNum();
+    header.triNum           = output.triNum();
+    header.pointOffset      = alignUp(sizeof(MeshSnapshotHeader));
+    header.constraintOffset = alignUp(header.pointOffset + header.pointNum * sizeof(Point));
+    header.triOffset        = alignUp(header.constraintOffset + header.constraintNum * sizeof(Edge));
+    header.triOppOffset     = alignUp(header.triOffset + header.triNum * sizeof(Tri));
+    header.infPt            = output.infPt;
+
+    uint64_t pos = 0;
+    writeBlock(outFile, pos, 0, &header, sizeof(header));
+    writeBlock(outFile, pos, header.pointOffset, input.points(), header.pointNum * sizeof(Point));
+    writeBlock(outFile, pos, header.constraintOffset, input.constraints(), header.constraintNum * sizeof(Edge));
+    writeBlock(outFile, pos, header.triOffset, output.tris(), header.triNum * sizeof(Tri));
+    writeBlock(outFile, pos, header.triOppOffset, output.triOpps(), header.triNum * sizeof(TriOpp));
+
+    if (!outFile)
+    {
+        throw std::runtime_error("MeshSnapshot: failed writing " + filename);
+    }
+}
+
+const MeshSnapshotHeader &checkMeshSnapshotHeader(const char *data, size_t size)
+{
+    if (size < sizeof(MeshSnapshotHeader))
+    {
+        throw std::runtime_error("MeshSnapshot: file too small for a header");
+    }
+
+    const auto &header = *reinterpret_cast<const MeshSnapshotHeader *>(data);
+
+    if (std::memcmp(header.magic, MeshSnapshotMagic, sizeof(header.magic)) != 0)
+    {
+        throw std::runtime_error("MeshSnapshot: bad magic");
+    }
+    if (header.version != MeshSnapshotVersion)
+    {
+        throw std::runtime_error("MeshSnapshot: unsupported version " + std::to_string(header.version));
+    }
+    if (!isArrayInFile(header.pointOffset, header.pointNum, sizeof(Point), size) ||
+        !isArrayInFile(header.constraintOffset, header.constraintNum, sizeof(Edge), size) ||
+        !isArrayInFile(header.triOffset, header.triNum, sizeof(Tri), size) ||
+        !isArrayInFile(header.triOppOffset, header.triNum, sizeof(TriOpp), size))
+    {
+        throw std::runtime_error("MeshSnapshot: truncated or corrupted file");
+    }
+
+    return header;
+}
+
+void loadMeshSnapshot(const std::string &filename, Input &input, Output &output)
+{
+    auto file = std::make_shared<const MappedFile>(filename);
+
+    const MeshSnapshotHeader &header = checkMeshSnapshotHeader(file->data(), file->size());
+
+    input.unmap();
+    Point2DHVec().swap(input.pointVec);
+    EdgeHVec().swap(input.constraintVec);
+    input.mappedFile          = file;
+    input.mappedPointArr      = reinterpret_cast<const Point *>(file->data() + header.pointOffset);
+    input.mappedPointNum      = header.pointNum;
+    input.mappedConstraintArr = reinterpret_cast<const Edge *>(file->data() + header.constraintOffset);
+    input.mappedConstraintNum = header.constraintNum;
+
+    output.reset();
+    output.mappedFile      = file;
+    output.mappedTriArr    = reinterpret_cast<const Tri *>(file->data() + header.triOffset);
+    output.mappedTriOppArr = reinterpret_cast<const TriOpp *>(file->data() + header.triOppOffset);
+    output.mappedTriNum    = header.triNum;
+    output.infPt           = header.infPt;
+}
+}
@@ -0,0 +1,54 @@
+#include "../include/ObjFile.h"
+#include "../include/ParallelWriter.h"
+
+namespace gdg
+{
+namespace
+{
+const char *const ObjColors[5] = {
+    " 0.8 0.2 0.2", // Red
+    " 0.9 0.6 0.2", // Orange
+    " 0.2 0.8 0.2", // Green
+    " 0.2 0.6 0.9", // Sky Blue
+    " 0.6 0.2 0.8"  // Purple
+};
+
+constexpr size_t MaxVertexLine = 2 + 3 * (MaxDoubleChars + 1) + 16;
+constexpr size_t MaxFaceLine   = 2 + 3 * (MaxIntChars + 1);
+}
+
+void writeObj(std::ostream &out,
+              const Point  *pointArr,
+              size_t        pointNum,
+              const Tri    *triArr,
+              size_t        triNum,
+              bool          withColor)
+{
+    writeParallel(out, pointNum, MaxVertexLine, [&](size_t i, char *ptr) {
+        const Point &pt = pointArr[i];
+        ptr             = writeStr(ptr, "v ");
+        ptr             = writeDouble(ptr, pt._p[0]);
+        *ptr++          = ' ';
+        ptr             = writeDouble(ptr, pt._p[1]);
+        *ptr++          = ' ';
+        ptr             = writeDouble(ptr, pt._p[2]);
+        if (withColor)
+            ptr = writeStr(ptr, ObjColors[i % 5]);
+        *ptr++ = '\n';
+        return ptr;
+    });
+
+    // OBJ indices are 1-based
+    writeParallel(out, triNum, MaxFaceLine, [&](size_t i, char *ptr) {
+        const Tri &tri = triArr[i];
+        ptr            = writeStr(ptr, "f ");
+        ptr            = writeInt(ptr, tri._v[0] + 1LL);
+        *ptr++         = ' ';
+        ptr            = writeInt(ptr, tri._v[1] + 1LL);
+        *ptr++         = ' ';
+        ptr            = writeInt(ptr, tri._v[2] + 1LL);
+        *ptr++         = '\n';
+        return ptr;
+    });
+}
+}
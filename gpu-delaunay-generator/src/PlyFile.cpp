@@ -0,0 +1,320 @@
+#include "../include/PlyFile.h"
+#include "../include/HostParallel.h"
+#include "../include/MappedFile.h"
+#include <cstdint>
+#include <cstring>
+
+namespace gdg
+{
+namespace
+{
+// Faces are packed into blocks of this many records before writing
+constexpr size_t PlyFaceBlock = 1 << 16;
+
+enum class PlyType
+{
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Float32,
+    Float64
+};
+
+struct PlyProperty
+{
+    std::string name;
+    PlyType     type;
+    bool        isList = false;
+    PlyType     countType{};
+};
+
+struct PlyElement
+{
+    std::string              name;
+    size_t                   num = 0;
+    std::vector<PlyProperty> properties;
+};
+
+PlyType parsePlyType(const std::string &str)
+{
+    if (str == "char" || str == "int8")
+        return PlyType::Int8;
+    if (str == "uchar" || str == "uint8")
+        return PlyType::UInt8;
+    if (str == "short" || str == "int16")
+        return PlyType::Int16;
+    if (str == "ushort" || str == "uint16")
+        return PlyType::UInt16;
+    if (str == "int" || str == "int32")
+        return PlyType::Int32;
+    if (str == "uint" || str == "uint32")
+        return PlyType::UInt32;
+    if (str == "float" || str == "float32")
+        return PlyType::Float32;
+    if (str == "double" || str == "float64")
+        return PlyType::Float64;
+    throw std::runtime_error("PlyFile: unknown property type " + str);
+}
+
+size_t plyTypeSize(PlyType type)
+{
+    switch (type)
+    {
+    case PlyType::Int8:
+    case PlyType::UInt8:
+        return 1;
+    case PlyType::Int16:
+    case PlyType::UInt16:
+        return 2;
+    case PlyType::Int32:
+    case PlyType::UInt32:
+    case PlyType::Float32:
+        return 4;
+    case PlyType::Float64:
+        return 8;
+    }
+    return 0;
+}
+
+template <typename T>
+double readAs(const char *ptr)
+{
+    T val;
+    std::memcpy(&val, ptr, sizeof(T));
+    return static_cast<double>(val);
+}
+
+double readPlyScalar(PlyType type, const char *ptr)
+{
+    switch (type)
+    {
+    case PlyType::Int8:
+        return readAs<int8_t>(ptr);
+    case PlyType::UInt8:
+        return readAs<uint8_t>(ptr);
+    case PlyType::Int16:
+        return readAs<int16_t>(ptr);
+    case PlyType::UInt16:
+        return readAs<uint16_t>(ptr);
+    case PlyType::Int32:
+        return readAs<int32_t>(ptr);
+    case PlyType::UInt32:
+        return readAs<uint32_t>(ptr);
+    case PlyType::Float32:
+        return readAs<float>(ptr);
+    case PlyType::Float64:
+        return readAs<double>(ptr);
+    }
+    return 0;
+}
+
+// Parse the header and return the offset of the first data byte
+size_t parsePlyHeader(const char *data, size_t size, std::vector<PlyElement> &elements)
+{
+    const char *end       = data + size;
+    const char *headerEnd = nullptr;
+    for (const char *p = data; p + 10 <= end; ++p)
+    {
+        if (std::memcmp(p, "end_header", 10) == 0)
+        {
+            headerEnd = p + 10;
+            break;
+        }
+    }
+    if (size < 3 || std::memcmp(data, "ply", 3) != 0 || headerEnd == nullptr)
+    {
+        throw std::runtime_error("PlyFile: not a PLY file");
+    }
+
+    std::istringstream header(std::string(data, headerEnd));
+    std::string        line;
+    while (std::getline(header, line))
+    {
+        std::istringstream words(line);
+        std::string        keyword;
+        words >> keyword;
+
+        if (keyword == "format")
+        {
+            std::string format;
+            words >> format;
+            if (format != "binary_little_endian")
+            {
+                throw std::runtime_error("PlyFile: only binary_little_endian is supported, got " + format);
+            }
+        }
+        else if (keyword == "element")
+        {
+            PlyElement element;
+            words >> element.name >> element.num;
+            elements.push_back(element);
+        }
+        else if (keyword == "property")
+        {
+            if (elements.empty())
+            {
+                throw std::runtime_error("PlyFile: property outside of an element");
+            }
+            PlyProperty property;
+            std::string type;
+            words >> type;
+            if (type == "list")
+            {
+                std::string countType, itemType;
+                words >> countType >> itemType;
+                property.isList    = true;
+                property.countType = parsePlyType(countType);
+                property.type      = parsePlyType(itemType);
+            }
+            else
+            {
+                property.type = parsePlyType(type);
+            }
+            words >> property.name;
+            elements.back().properties.push_back(property);
+        }
+    }
+
+    // The data starts after the newline ending the header
+    const char *dataBegin = headerEnd;
+    while (dataBegin < end && *dataBegin != '\n')
+        ++dataBegin;
+    if (dataBegin == end)
+    {
+        throw std::runtime_error("PlyFile: truncated header");
+    }
+    return static_cast<size_t>(dataBegin + 1 - data);
+}
+
+// Byte size of the element data starting at offset
+size_t skipPlyElement(const PlyElement &element, const char *data, size_t offset, size_t size)
+{
+    const size_t begin = offset;
+    for (size_t i = 0; i < element.num; ++i)
+    {
+        for (const auto &property : element.properties)
+        {
+            // offset never passes size, so size - offset cannot wrap
+            size_t bytes = plyTypeSize(property.type);
+            if (property.isList)
+            {
+                if (plyTypeSize(property.countType) > size - offset)
+                    throw std::runtime_error("PlyFile: truncated file");
+                const auto count = static_cast<size_t>(readPlyScalar(property.countType, data + offset));
+                offset += plyTypeSize(property.countType);
+                if (count > (size - offset) / bytes)
+                    throw std::runtime_error("PlyFile: truncated file");
+                bytes *= count;
+            }
+            if (bytes > size - offset)
+                throw std::runtime_error("PlyFile: truncated file");
+            offset += bytes;
+        }
+    }
+    return offset - begin;
+}
+}
+
+void writePly(std::ostream &out, const Point *pointArr, size_t pointNum, const Tri *triArr, size_t triNum)
+{
+    out << "ply\n"
+        << "format binary_little_endian 1.0\n"
+        << "element vertex " << pointNum << "\n"
+        << "property double x\n"
+        << "property double y\n"
+        << "property double z\n"
+        << "element face " << triNum << "\n"
+        << "property list uchar int vertex_indices\n"
+        << "end_header\n";
+
+    // Point is exactly three doubles, so the array is already a vertex block
+    static_assert(sizeof(Point) == 3 * sizeof(double), "Point must be three packed doubles");
+    static_assert(sizeof(Tri) == 3 * sizeof(int), "Tri must be three packed ints");
+    out.write(reinterpret_cast<const char *>(pointArr), static_cast<std::streamsize>(pointNum * sizeof(Point)));
+
+    constexpr size_t  FaceSize = 1 + sizeof(Tri);
+    std::vector<char> buffer(std::min(triNum, PlyFaceBlock) * FaceSize);
+    for (size_t first = 0; first < triNum; first += PlyFaceBlock)
+    {
+        const size_t num = std::min(PlyFaceBlock, triNum - first);
+        char        *ptr = buffer.data();
+        for (size_t i = first; i < first + num; ++i, ptr += FaceSize)
+        {
+            ptr[0] = 3;
+            std::memcpy(ptr + 1, triArr[i]._v, sizeof(Tri));
+        }
+        out.write(buffer.data(), static_cast<std::streamsize>(num * FaceSize));
+    }
+
+    if (!out)
+    {
+        throw std::runtime_error("PlyFile: failed writing PLY data");
+    }
+}
+
+void readPlyPoints(const std::string &filename, Point2DHVec &pointVec)
+{
+    const MappedFile file(filename);
+    const char      *data = file.data();
+    const size_t     size = file.size();
+
+    std::vector<PlyElement> elements;
+    size_t                  offset = parsePlyHeader(data, size, elements);
+
+    for (const auto &element : elements)
+    {
+        if (element.name != "vertex")
+        {
+            offset += skipPlyElement(element, data, offset, size);
+            continue;
+        }
+
+        size_t  stride    = 0;
+        size_t  coorOffset[3];
+        PlyType coorType[3];
+        int     found = 0;
+        for (const auto &property : element.properties)
+        {
+            if (property.isList)
+            {
+                throw std::runtime_error("PlyFile: list properties on vertices are not supported");
+            }
+            const int axis = (property.name == "x") ? 0 : (property.name == "y") ? 1 : (property.name == "z") ? 2 : -1;
+            if (axis >= 0)
+            {
+                coorOffset[axis] = stride;
+                coorType[axis]   = property.type;
+                found |= 1 << axis;
+            }
+            stride += plyTypeSize(property.type);
+        }
+        if (found != 7)
+        {
+            throw std::runtime_error("PlyFile: vertices need x, y and z properties");
+        }
+        if (offset > size || element.num > (size - offset) / std::max<size_t>(stride, 1))
+        {
+            throw std::runtime_error("PlyFile: truncated file");
+        }
+
+        const size_t first = pointVec.size();
+        pointVec.resize(first + element.num);
+        const char *vertData = data + offset;
+        parallelFor(element.num, [&](int, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                const char *rec = vertData + i * stride;
+                Point      &pt  = pointVec[first + i];
+                for (int j = 0; j < 3; ++j)
+                    pt._p[j] = readPlyScalar(coorType[j], rec + coorOffset[j]);
+            }
+        });
+        return;
+    }
+
+    throw std::runtime_error("PlyFile: no vertex element in " + filename);
+}
+}
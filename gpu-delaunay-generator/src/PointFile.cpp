@@ -0,0 +1,105 @@
+#include "../include/PointFile.h"
+#include <cstring>
+
+namespace gdg
+{
+namespace
+{
+uint64_t alignUp(uint64_t offset)
+{
+    return (offset + PointFileAlign - 1) / PointFileAlign * PointFileAlign;
+}
+
+void writePadding(std::ofstream &outFile, uint64_t from, uint64_t to)
+{
+    const char zeros[PointFileAlign] = {};
+    outFile.write(zeros, static_cast<std::streamsize>(to - from));
+}
+}
+
+bool isPointFile(const std::string &filename)
+{
+    std::ifstream inFile(filename, std::ios::binary);
+    char          magic[4] = {};
+    inFile.read(magic, sizeof(magic));
+    return inFile && std::memcmp(magic, PointFileMagic, sizeof(magic)) == 0;
+}
+
+void writePointFile(const std::string &filename,
+                    const Point       *pointArr,
+                    size_t             pointNum,
+                    const Edge        *constraintArr,
+                    size_t             constraintNum)
+{
+    std::ofstream outFile(filename, std::ios::binary);
+    if (!outFile.is_open())
+    {
+        throw std::runtime_error("PointFile: cannot write " + filename);
+    }
+
+    PointFileHeader header{};
+    std::memcpy(header.magic, PointFileMagic, sizeof(header.magic));
+    header.version          = PointFileVersion;
+    header.pointNum         = pointNum;
+    header.constraintNum    = constraintNum;
+    header.pointOffset      = alignUp(sizeof(PointFileHeader));
+    header.constraintOffset = alignUp(header.pointOffset + pointNum * sizeof(Point));
+
+    for (int i = 0; i < 3; ++i)
+    {
+        header.minVal[i] = pointNum ? DBL_MAX : 0;
+        header.maxVal[i] = pointNum ? -DBL_MAX : 0;
+    }
+    for (size_t i = 0; i < pointNum; ++i)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            header.minVal[j] = std::min(header.minVal[j], pointArr[i]._p[j]);
+            header.maxVal[j] = std::max(header.maxVal[j], pointArr[i]._p[j]);
+        }
+    }
+
+    outFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    writePadding(outFile, sizeof(header), header.pointOffset);
+    outFile.write(reinterpret_cast<const char *>(pointArr), static_cast<std::streamsize>(pointNum * sizeof(Point)));
+    writePadding(outFile, header.pointOffset + pointNum * sizeof(Point), header.constraintOffset);
+    outFile.write(reinterpret_cast<const char *>(constraintArr),
+                  static_cast<std::streamsize>(constraintNum * sizeof(Edge)));
+
+    if (!outFile)
+    {
+        throw std::runtime_error("PointFile: failed writing " + filename);
+    }
+}
+
+bool isArrayInFile(uint64_t offset, uint64_t num, uint64_t elemSize, size_t size)
+{
+    return offset % PointFileAlign == 0 && offset <= size && num <= (size - offset) / elemSize;
+}
+
+const PointFileHeader &checkPointFileHeader(const char *data, size_t size)
+{
+    if (size < sizeof(PointFileHeader))
+    {
+        throw std::runtime_error("PointFile: file too small for a header");
+    }
+
+    const auto &header = *reinterpret_cast<const PointFileHeader *>(data);
+
+    if (std::memcmp(header.magic, PointFileMagic, sizeof(header.magic)) != 0)
+    {
+        throw std::runtime_error("PointFile: bad magic");
+    }
+    if (header.version != PointFileVersion)
+    {
+        throw std::runtime_error("PointFile: unsupported version " + std::to_string(header.version));
+    }
+    if (!isArrayInFile(header.pointOffset, header.pointNum, sizeof(Point), size) ||
+        !isArrayInFile(header.constraintOffset, header.constraintNum, sizeof(Edge), size))
+    {
+        throw std::runtime_error("PointFile: truncated or corrupted file");
+    }
+
+    return header;
+}
+}
@@ -0,0 +1,319 @@
+#include "../include/ResultCache.h"
+#include "../include/HostParallel.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <unistd.h>
+
+#ifndef GDG_GIT_REVISION
+#define GDG_GIT_REVISION "unknown"
+#endif
+
+namespace fs = std::filesystem;
+
+namespace gdg
+{
+namespace
+{
+constexpr char     ResultCacheMagic[4] = {'G', 'D', 'G', 'R'};
+constexpr uint32_t ResultCacheVersion  = 2;
+constexpr char     ResultCacheExt[]    = ".gdr";
+constexpr char     ResultCacheBuild[]  = GDG_GIT_REVISION; // Entries from other builds may differ
+
+// Temporary files older than this are left over by an interrupted store;
+// younger ones may belong to another process still writing
+constexpr auto ResultCacheTmpAge = std::chrono::hours(1);
+
+// Numbers the temporary files of this process
+std::atomic<uint64_t> tmpCounter{0};
+
+// Words hashed together; chunk hashes are combined in order so the key does
+// not depend on how the chunks are spread over threads
+constexpr size_t HashChunkWords = 1 << 14;
+
+struct ResultCacheHeader
+{
+    char     magic[4];
+    uint32_t version;
+    char     build[24];
+    uint64_t hash[2];
+    uint64_t pointNum;
+    uint64_t constraintNum;
+    uint64_t triNum;
+    Point    infPt;
+};
+
+inline uint64_t rotl(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+inline uint64_t fmix(uint64_t k)
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+struct Hash128
+{
+    uint64_t h1 = 0x9e3779b97f4a7c15ULL;
+    uint64_t h2 = 0x6a09e667f3bcc908ULL;
+
+    // Murmur3-style mixing of one 64-bit word per step into both lanes
+    void addWords(const char *data, size_t wordNum)
+    {
+        constexpr uint64_t C1 = 0x87c37b91114253d5ULL;
+        constexpr uint64_t C2 = 0x4cf5ad432745937fULL;
+        for (size_t i = 0; i < wordNum; ++i)
+        {
+            uint64_t w;
+            std::memcpy(&w, data + i * sizeof(w), sizeof(w));
+            h1 ^= rotl(w * C1, 31) * C2;
+            h1 = rotl(h1, 27) + h2;
+            h1 = h1 * 5 + 0x52dce729;
+            h2 ^= rotl(w * C2, 33) * C1;
+            h2 = rotl(h2, 31) + h1;
+            h2 = h2 * 5 + 0x38495ab5;
+        }
+    }
+
+    void add(uint64_t w)
+    {
+        addWords(reinterpret_cast<const char *>(&w), 1);
+    }
+
+    void finish(uint64_t len)
+    {
+        h1 ^= len;
+        h2 ^= len;
+        h1 += h2;
+        h2 += h1;
+        h1 = fmix(h1);
+        h2 = fmix(h2);
+        h1 += h2;
+        h2 += h1;
+    }
+};
+
+void hashArray(Hash128 &hash, const void *data, size_t byteNum)
+{
+    const char          *bytes    = static_cast<const char *>(data);
+    const size_t         wordNum  = byteNum / sizeof(uint64_t);
+    const size_t         chunkNum = (wordNum + HashChunkWords - 1) / HashChunkWords;
+    std::vector<Hash128> chunkHashes(chunkNum);
+
+    // Each thread takes the chunks starting in its range
+    parallelFor(wordNum, [&](int, size_t begin, size_t end) {
+        for (size_t c = (begin + HashChunkWords - 1) / HashChunkWords; c * HashChunkWords < end; ++c)
+        {
+            const size_t first = c * HashChunkWords;
+            const size_t num   = std::min(HashChunkWords, wordNum - first);
+            chunkHashes[c].addWords(bytes + first * sizeof(uint64_t), num);
+            chunkHashes[c].finish(num);
+        }
+    });
+
+    for (const Hash128 &chunkHash : chunkHashes)
+    {
+        hash.add(chunkHash.h1);
+        hash.add(chunkHash.h2);
+    }
+
+    // Trailing bytes, zero padded to a word
+    uint64_t tail = 0;
+    if (byteNum % sizeof(uint64_t) != 0)
+        std::memcpy(&tail, bytes + wordNum * sizeof(uint64_t), byteNum % sizeof(uint64_t));
+    hash.add(tail);
+    hash.add(byteNum);
+}
+}
+
+std::string ResultCacheKey::name() const
+{
+    char str[33];
+    std::snprintf(str, sizeof(str), "%016llx%016llx", (unsigned long long)hash[0], (unsigned long long)hash[1]);
+    return str;
+}
+
+ResultCacheKey makeResultCacheKey(const Input &input)
+{
+    Hash128 hash;
+    hashArray(hash, input.points(), input.pointNum() * sizeof(Point));
+    hashArray(hash, input.constraints(), input.constraintNum() * sizeof(Edge));
+    hashArray(hash, ResultCacheBuild, sizeof(ResultCacheBuild) - 1);
+    hash.add((uint64_t)input.insAll | ((uint64_t)input.noSort << 1) | ((uint64_t)input.noReorder << 2));
+    hash.finish(input.pointNum());
+
+    return {{hash.h1, hash.h2}, input.pointNum(), input.constraintNum()};
+}
+
+ResultCache::ResultCache(const std::string &directory, uint64_t capacity) : directory(directory), capacity(capacity)
+{
+    fs::create_directories(directory);
+
+    std::vector<std::pair<fs::file_time_type, Entry>> found;
+    for (const auto &file : fs::directory_iterator(directory))
+    {
+        if (!file.is_regular_file())
+            continue;
+        const fs::path &filePath = file.path();
+        if (filePath.extension() == ".tmp")
+        {
+            if (fs::file_time_type::clock::now() - file.last_write_time() > ResultCacheTmpAge)
+            {
+                std::error_code ec;
+                fs::remove(filePath, ec);
+            }
+        }
+        else if (filePath.extension() == ResultCacheExt)
+        {
+            found.push_back({file.last_write_time(), {filePath.stem().string(), file.file_size()}});
+        }
+    }
+
+    std::sort(found.begin(), found.end(), [](const auto &a, const auto &b) { return a.first > b.first; });
+    for (const auto &item : found)
+    {
+        lruList.push_back(item.second);
+        entryMap[item.second.name] = std::prev(lruList.end());
+        totalSize += item.second.size;
+    }
+    evict();
+}
+
+std::string ResultCache::path(const std::string &name) const
+{
+    return (fs::path(directory) / (name + ResultCacheExt)).string();
+}
+
+void ResultCache::touch(EntryIter iter)
+{
+    lruList.splice(lruList.begin(), lruList, iter);
+
+    std::error_code ec;
+    fs::last_write_time(path(iter->name), fs::file_time_type::clock::now(), ec);
+}
+
+void ResultCache::remove(EntryIter iter)
+{
+    std::error_code ec;
+    fs::remove(path(iter->name), ec);
+    totalSize -= iter->size;
+    entryMap.erase(iter->name);
+    lruList.erase(iter);
+}
+
+void ResultCache::evict()
+{
+    while (totalSize > capacity && !lruList.empty())
+    {
+        remove(std::prev(lruList.end()));
+        ++cacheStats.evictNum;
+    }
+}
+
+bool ResultCache::load(const ResultCacheKey &key, Output &output)
+{
+    const auto found = entryMap.find(key.name());
+    if (found == entryMap.end())
+    {
+        ++cacheStats.missNum;
+        return false;
+    }
+
+    std::ifstream     inFile(path(found->second->name), std::ios::binary);
+    ResultCacheHeader header{};
+    inFile.read(reinterpret_cast<char *>(&header), sizeof(header));
+
+    const bool valid = inFile && std::memcmp(header.magic, ResultCacheMagic, sizeof(header.magic)) == 0 &&
+                       header.version == ResultCacheVersion &&
+                       std::strncmp(header.build, ResultCacheBuild, sizeof(header.build) - 1) == 0 &&
+                       header.hash[0] == key.hash[0] && header.hash[1] == key.hash[1] &&
+                       header.pointNum == key.pointNum && header.constraintNum == key.constraintNum &&
+                       found->second->size == sizeof(header) + header.triNum * (sizeof(Tri) + sizeof(TriOpp));
+    if (!valid)
+    {
+        remove(found->second);
+        ++cacheStats.missNum;
+        return false;
+    }
+
+    output.reset();
+    output.infPt = header.infPt;
+    output.triVec.resize(header.triNum);
+    output.triOppVec.resize(header.triNum);
+    inFile.read(reinterpret_cast<char *>(output.triVec.data()), header.triNum * sizeof(Tri));
+    inFile.read(reinterpret_cast<char *>(output.triOppVec.data()), header.triNum * sizeof(TriOpp));
+    if (!inFile)
+    {
+        output.reset();
+        remove(found->second);
+        ++cacheStats.missNum;
+        return false;
+    }
+
+    touch(found->second);
+    ++cacheStats.hitNum;
+    return true;
+}
+
+void ResultCache::store(const ResultCacheKey &key, const Output &output)
+{
+    const std::string name  = key.name();
+    const auto        found = entryMap.find(name);
+    if (found != entryMap.end())
+    {
+        touch(found->second);
+        return;
+    }
+
+    ResultCacheHeader header{};
+    std::memcpy(header.magic, ResultCacheMagic, sizeof(header.magic));
+    header.version       = ResultCacheVersion;
+    std::strncpy(header.build, ResultCacheBuild, sizeof(header.build) - 1);
+    header.hash[0]       = key.hash[0];
+    header.hash[1]       = key.hash[1];
+    header.pointNum      = key.pointNum;
+    header.constraintNum = key.constraintNum;
+    header.triNum        = output.triNum();
+    header.infPt         = output.infPt;
+
+    const uint64_t size = sizeof(header) + header.triNum * (sizeof(Tri) + sizeof(TriOpp));
+    if (size > capacity)
+        return;
+
+    // Write to a temporary file first so a crash never leaves a partial entry;
+    // its name is unique so processes sharing the directory never collide
+    const std::string tmpPath =
+        path(name) + "." + std::to_string(getpid()) + "-" + std::to_string(tmpCounter++) + ".tmp";
+    {
+        std::ofstream outFile(tmpPath, std::ios::binary);
+        outFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        outFile.write(reinterpret_cast<const char *>(output.tris()), header.triNum * sizeof(Tri));
+        outFile.write(reinterpret_cast<const char *>(output.triOpps()), header.triNum * sizeof(TriOpp));
+        if (!outFile)
+        {
+            std::error_code ec;
+            fs::remove(tmpPath, ec);
+            throw std::runtime_error("ResultCache: failed writing " + tmpPath);
+        }
+    }
+    fs::rename(tmpPath, path(name));
+
+    lruList.push_front({name, size});
+    entryMap[name] = lruList.begin();
+    totalSize += size;
+    evict();
+}
+
+const ResultCacheStats &ResultCache::stats() const
+{
+    return cacheStats;
+}
+}
@@ -0,0 +1,132 @@
+#include "../include/VertexTriIndex.h"
+#include "../include/HostParallel.h"
+#include <atomic>
+#include <memory>
+
+namespace gdg
+{
+VertexTriIndex::VertexTriIndex(const TriHVec &triVec, size_t vertNum)
+{
+    build(triVec, vertNum);
+}
+
+VertexTriIndex::VertexTriIndex(const Tri *triArr, size_t triNum, size_t vertNum)
+{
+    build(triArr, triNum, vertNum);
+}
+
+void VertexTriIndex::build(const TriHVec &triVec, size_t vertNum)
+{
+    build(triVec.data(), triVec.size(), vertNum);
+}
+
+void VertexTriIndex::build(const Tri *triArr, size_t triNum, size_t vertNum)
+{
+    // Counting sort: per-vertex degree, exclusive scan, then scatter
+    std::unique_ptr<std::atomic<int>[]> cursor(new std::atomic<int>[vertNum]());
+
+    parallelFor((int)triNum, [&](int, int begin, int end) {
+        for (int ti = begin; ti < end; ++ti)
+            for (int v : triArr[ti]._v)
+                cursor[v].fetch_add(1, std::memory_order_relaxed);
+    });
+
+    offsetVec.resize(vertNum + 1);
+
+    std::vector<int> chunkSum(parallelThreadNum(vertNum), 0);
+
+    parallelFor(vertNum, [&](int t, size_t begin, size_t end) {
+        int sum = 0;
+        for (size_t v = begin; v < end; ++v)
+            sum += cursor[v].load(std::memory_order_relaxed);
+        chunkSum[t] = sum;
+    });
+
+    int total = 0;
+    for (int &sum : chunkSum)
+    {
+        const int count = sum;
+        sum             = total;
+        total += count;
+    }
+
+    parallelFor(vertNum, [&](int t, size_t begin, size_t end) {
+        int offset = chunkSum[t];
+        for (size_t v = begin; v < end; ++v)
+        {
+            const int count = cursor[v].load(std::memory_order_relaxed);
+            offsetVec[v]    = offset;
+            cursor[v].store(offset, std::memory_order_relaxed);
+            offset += count;
+        }
+    });
+    offsetVec[vertNum] = total;
+
+    triViVec.resize(total);
+
+    parallelFor((int)triNum, [&](int, int begin, int end) {
+        for (int ti = begin; ti < end; ++ti)
+            for (int vi = 0; vi < DEG; ++vi)
+            {
+                const int pos = cursor[triArr[ti]._v[vi]].fetch_add(1, std::memory_order_relaxed);
+                triViVec[pos] = (ti << 2) | vi;
+            }
+    });
+
+    parallelFor(vertNum, [&](int, size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v)
+            std::sort(triViVec.begin() + offsetVec[v], triViVec.begin() + offsetVec[v + 1]);
+    });
+}
+
+size_t VertexTriIndex::vertNum() const
+{
+    return offsetVec.empty() ? 0 : offsetVec.size() - 1;
+}
+
+int VertexTriIndex::degree(int v) const
+{
+    return offsetVec[v + 1] - offsetVec[v];
+}
+
+int VertexTriIndex::starTri(int v, int i) const
+{
+    return triViVec[offsetVec[v] + i] >> 2;
+}
+
+int VertexTriIndex::starVi(int v, int i) const
+{
+    return triViVec[offsetVec[v] + i] & 3;
+}
+
+int VertexTriIndex::findEdge(int v0, int v1, int &oppVi) const
+{
+    oppVi = -1;
+
+    if (v0 < 0 || v1 < 0 || v0 == v1 || (size_t)v0 >= vertNum() || (size_t)v1 >= vertNum())
+        return -1;
+
+    // Both stars are sorted by triangle index, so the triangles sharing the
+    // edge are found by merging them
+    int i0 = offsetVec[v0];
+    int i1 = offsetVec[v1];
+
+    while (i0 < offsetVec[v0 + 1] && i1 < offsetVec[v1 + 1])
+    {
+        const int t0 = triViVec[i0] >> 2;
+        const int t1 = triViVec[i1] >> 2;
+
+        if (t0 < t1)
+            ++i0;
+        else if (t1 < t0)
+            ++i1;
+        else
+        {
+            oppVi = DEG - (triViVec[i0] & 3) - (triViVec[i1] & 3);
+            return t0;
+        }
+    }
+
+    return -1;
+}
+}
@@ -0,0 +1,99 @@
+#ifndef DELAUNAY_GENERATOR_BATCHHANDLER_H
+#define DELAUNAY_GENERATOR_BATCHHANDLER_H
+
+#include "Pipeline.h"
+#include "TriangulationHandler.h"
+#include <atomic>
+#include <mutex>
+
+struct BatchTile
+{
+    std::string inputFilename;
+    std::string constraintFilename; // Empty if the tile has no constraints
+    std::string outputFilename;
+};
+
+struct BatchTileStat
+{
+    bool        done = false;
+    std::string error; // Empty if the tile succeeded
+    size_t      pointNum    = 0;
+    size_t      triNum      = 0;
+    double      readTime    = .0; // ms
+    double      computeTime = .0;
+    double      writeTime   = .0;
+};
+
+// Manifest lines are "input output" or "input constraints output", separated
+// by whitespace; empty lines and lines starting with # are skipped
+std::vector<BatchTile> readBatchManifest(const std::string &filename);
+
+// True if the config names a batch manifest in BatchManifest
+bool isBatchConfig(const char *InputYAMLFile);
+
+// A tile moving through the pipeline
+struct BatchJob
+{
+    size_t      tileIdx = 0;
+    size_t      bytes   = 0; // Estimated memory held by the tile until it is written
+    gdg::Input  input;
+    gdg::Output output;
+};
+
+// Triangulate every tile of a manifest in a three-stage pipeline: reader
+// threads parse inputs, the GPU stage triangulates one tile at a time with a
+// GpuDel that keeps its device buffers, and writer threads save the results.
+// Stages are linked by bounded queues and the tiles in flight are capped in
+// memory, so tile N+1 is read and tile N-1 written while tile N is computed.
+// A tile that throws is reported and skipped without stopping the others.
+class BatchHandler
+{
+  private:
+    BatchHandler() = default;
+
+    void readStage();
+    void computeStage();
+    void storeResult(const gdg::ResultCacheKey &cacheKey, const gdg::Output &output);
+    void writeStage();
+    void finishTile(size_t tileIdx);
+    void addBusyTime(double &stageBusy, double time);
+    void saveStats() const;
+
+    int              deviceId    = 0;
+    int              readerNum   = 2;
+    int              writerNum   = 2;
+    size_t           queueSize   = 2;
+    size_t           memoryCap   = size_t(4) << 30; // Bytes
+    bool             insAll      = false;
+    bool             noSort      = false;
+    bool             noReorder   = false;
+    gdg::LasFilter   lasFilter;
+    MeshOutputOption outputOption;
+    std::string      statsFilename;
+
+    std::vector<BatchTile>     tiles;
+    std::vector<BatchTileStat> tileStats;
+    std::atomic<size_t>        nextTile{0};
+    std::atomic<size_t>        doneNum{0};
+    std::atomic<int>           readerDoneNum{0};
+    std::mutex                 logMutex;
+
+    std::unique_ptr<BoundedQueue<std::unique_ptr<BatchJob>>> readQueue;
+    std::unique_ptr<BoundedQueue<std::unique_ptr<BatchJob>>> writeQueue;
+    std::unique_ptr<MemoryBudget>                            memoryBudget;
+    std::unique_ptr<gdg::ResultCache>                        resultCache; // Used by the GPU stage only
+
+    // Busy time of each stage summed over its threads (ms), excluding the
+    // time spent waiting on queues and the memory cap
+    double readBusy    = .0;
+    double computeBusy = .0;
+    double writeBusy   = .0;
+
+  public:
+    explicit BatchHandler(const char *InputYAMLFile);
+    void run();
+
+    size_t failedNum() const;
+};
+
+#endif //DELAUNAY_GENERATOR_BATCHHANDLER_H
@@ -0,0 +1,28 @@
+#ifndef DELAUNAY_GENERATOR_CONSTRAINTGENERATOR_H
+#define DELAUNAY_GENERATOR_CONSTRAINTGENERATOR_H
+
+#include "gpu-delaunay-generator.h"
+
+enum ConstraintShape
+{
+    NoConstraintShape,
+    PolygonConstraintShape,   // Star-shaped polygons, each with a hole once it has 8 sides or more
+    BreaklineConstraintShape, // Polylines across the whole square, one per horizontal band
+    RoadConstraintShape       // Jittered street grid with some streets left out
+};
+
+struct ConstraintGeneratorOption
+{
+    ConstraintShape shape         = NoConstraintShape;
+    int             constraintNum = 1000; // Edges to make, roughly
+    int             segmentNum    = 16;   // Edges per polygon ring, breakline or street between crossings
+
+    void setShapeFromStr(const std::string &shapeStr);
+};
+
+// Add a set of non-crossing constraints in the unit square to input. Their
+// vertices are appended to the points; fewer segments per feature give
+// longer edges that cross more triangles.
+void makeConstraints(const ConstraintGeneratorOption &option, int seed, gdg::Input &input);
+
+#endif //DELAUNAY_GENERATOR_CONSTRAINTGENERATOR_H
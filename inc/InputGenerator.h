@@ -1,8 +1,11 @@
 #ifndef DELAUNAY_GENERATOR_INPUTCREATOR_H
 #define DELAUNAY_GENERATOR_INPUTCREATOR_H
 
+#include "ConstraintGenerator.h"
 #include "gpu-delaunay-generator.h"
+#include "include/LasReader.h"
 #include "RandGen.h"
+#include "SyntheticScene.h"
 
 enum Distribution
 {
@@ -13,20 +16,29 @@ enum Distribution
     CircleDistribution,
     GridDistribution,
     EllipseDistribution,
-    TwoLineDistribution
+    TwoLineDistribution,
+    // Lidar-like, with fractal terrain heights (see SyntheticScene.h)
+    TerrainDistribution,
+    VoidDistribution,
+    ClusterDistribution,
+    SwathDistribution
 };
 
 struct InputGeneratorOption
 {
-    bool         inputFromFile = false;
-    std::string  inputFilename;
-    bool         inputConstraint = false;
-    std::string  inputConstraintFilename;
-    int          pointNum     = 1000;
-    Distribution distribution = UniformDistribution;
-    int          seed         = 76213898;
-    bool         saveToFile   = false;
-    std::string  saveFilename;
+    bool           inputFromFile = false;
+    std::string    inputFilename;
+    bool           inputConstraint = false;
+    std::string    inputConstraintFilename;
+    gdg::LasFilter lasFilter;
+    int            pointNum     = 1000;
+    Distribution   distribution = UniformDistribution;
+    int            seed         = 76213898;
+    bool           legacyRandom = false; // Reproduce inputs of the sequential generator
+    bool           saveToFile   = false;
+    std::string    saveFilename;
+
+    ConstraintGeneratorOption constraintOption; // For generated points
 
     void setDistributionFromStr(const std::string &distributionStr);
 };
@@ -34,29 +46,13 @@ struct InputGeneratorOption
 class InputGenerator
 {
   private:
-    RandGen                     randGen;
     const InputGeneratorOption &option;
     gdg::Input                      &input;
 
-    void randCirclePoint(double &x, double &y);
-
     void makePoints();
 
-    void makePointsUniform();
-
-    void makePointsGaussian();
-
-    void makePointsDisk();
-
-    void makePointsThinCircle();
-
-    void makePointsCircle();
-
-    void makePointsGrid();
-
-    void makePointsEllipse();
-
-    void makePointsTwoLine();
+    template <typename MakePoint>
+    void makeStreamPoints(size_t pointNum, MakePoint makePoint);
 
     void readPoints();
 
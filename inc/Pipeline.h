@@ -0,0 +1,92 @@
+#ifndef DELAUNAY_GENERATOR_PIPELINE_H
+#define DELAUNAY_GENERATOR_PIPELINE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+// Queue between two pipeline stages; push() blocks while the queue is full
+// so a slow consumer holds back its producers
+template <typename T>
+class BoundedQueue
+{
+  private:
+    std::mutex              mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+    std::deque<T>           items;
+    size_t                  capacity;
+    bool                    closed = false;
+
+  public:
+    explicit BoundedQueue(size_t capacity) : capacity(capacity > 0 ? capacity : 1) {}
+
+    void push(T item)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this] { return items.size() < capacity; });
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+    }
+
+    // Blocks while the queue is empty; returns false once it is closed and drained
+    bool pop(T &item)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this] { return !items.empty() || closed; });
+        if (items.empty())
+            return false;
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    // No more items will be pushed
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        notEmpty.notify_all();
+    }
+};
+
+// Caps the bytes held by items in flight. acquire() blocks until the bytes
+// fit, except when nothing is held, so a single item larger than the cap
+// still goes through.
+class MemoryBudget
+{
+  private:
+    std::mutex              mutex;
+    std::condition_variable released;
+    size_t                  capacity;
+    size_t                  used = 0;
+
+  public:
+    explicit MemoryBudget(size_t capacity) : capacity(capacity) {}
+
+    void acquire(size_t bytes)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        released.wait(lock, [&] { return used == 0 || used + bytes <= capacity; });
+        used += bytes;
+    }
+
+    // Replace the bytes held for a tile by its actual size, without waiting:
+    // a holder blocked on the cap could otherwise stall the other holders
+    void adjust(size_t oldBytes, size_t newBytes)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        used = used - oldBytes + newBytes;
+        released.notify_all();
+    }
+
+    void release(size_t bytes)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        used -= bytes;
+        released.notify_all();
+    }
+};
+
+#endif //DELAUNAY_GENERATOR_PIPELINE_H
@@ -1,12 +1,42 @@
 #ifndef DELAUNAY_GENERATOR_RANDGEN_H
 #define DELAUNAY_GENERATOR_RANDGEN_H
 
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Pair of standard normal values by the polar method, redrawn until both lie
+// in [-3, 3). random() draws uniformly from [0, 1).
+template <typename Random>
+void polarGaussian(Random random, double &x, double &y)
+{
+    double x1, x2, w;
+
+    do
+    {
+        do
+        {
+            x1 = 2.0 * random() - 1.0;
+            x2 = 2.0 * random() - 1.0;
+            w  = x1 * x1 + x2 * x2;
+        } while (w >= 1.0 || w == 0.0);
+
+        w = std::sqrt((-2.0 * std::log(w)) / w);
+        x = x1 * w;
+        y = x2 * w;
+    } while (x < -3 || x >= 3 || y < -3 || y >= 3);
+}
+
 class RandGen
 {
   public:
     RandGen() = default;
     void          init(int, double, double);
     double        getNext();
+    // Same values and final state as n calls to getNext(). The sequence is
+    // split into lanes, each started by jumping ahead, and the lanes are
+    // stepped together so the compiler can vectorize them.
+    void          fillUniform(double *, size_t);
     void          nextGaussian(double &, double &);
     unsigned long rand_int();
 
@@ -26,4 +56,30 @@ class RandGen
     double        random();
 };
 
+// Counter-based generator (Philox4x32-10). The values of a stream depend only
+// on the seed and the stream index, so independent streams can be drawn by
+// any number of threads with the same result.
+class PhiloxRandGen
+{
+  public:
+    PhiloxRandGen() = default;
+    void   init(int, double, double);
+    // Restart at the first value of the given stream
+    void   setStream(uint64_t);
+    double getNext();
+    void   nextGaussian(double &, double &);
+
+  private:
+    uint32_t _key[2]  = {0, 0};
+    uint64_t _stream  = 0;
+    uint64_t _counter = 0;
+    uint32_t _buf[4]  = {0, 0, 0, 0};
+    int      _bufPos  = 4;
+    double   _min     = 0;
+    double   _max     = 0;
+
+    void   refill();
+    double random();
+};
+
 #endif //DELAUNAY_GENERATOR_RANDGEN_H
\ No newline at end of file
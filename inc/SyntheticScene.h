@@ -0,0 +1,48 @@
+#ifndef DELAUNAY_GENERATOR_SYNTHETICSCENE_H
+#define DELAUNAY_GENERATOR_SYNTHETICSCENE_H
+
+#include "RandGen.h"
+#include "gpu-delaunay-generator.h"
+#include <vector>
+
+// Seeded landscape in the unit square for the lidar-like distributions:
+// fractal terrain heights, lakes where the terrain is low, vegetation
+// clusters and the flight swaths of an airborne scan. The scene is fixed by
+// the seed; each point is then drawn from its own stream, so points can be
+// made in parallel.
+class SyntheticScene
+{
+  private:
+    struct Cluster
+    {
+        double x, y;
+        double sigma;
+        double weight; // Cumulative, the last one is 1
+    };
+
+    int                  perm[512]; // Noise lattice permutation, repeated
+    std::vector<Cluster> clusters;
+    int                  swathNum;
+    int                  lineNum; // Scan lines per swath
+
+    double noise(double x, double y) const;
+    bool   isLand(double x, double y) const;
+    void   setHeight(gdg::Point &p) const;
+
+  public:
+    SyntheticScene(int seed, size_t pointNum);
+
+    // Fractal Brownian motion of gradient noise, about [-1, 1]
+    double height(double x, double y) const;
+
+    // Uniform over the square, terrain heights
+    void makeTerrainPoint(PhiloxRandGen &randGen, gdg::Point &p) const;
+    // Uniform over land, leaving the lakes empty
+    void makeVoidPoint(PhiloxRandGen &randGen, gdg::Point &p) const;
+    // Gaussian mixture of vegetation clumps over sparse ground returns
+    void makeClusterPoint(PhiloxRandGen &randGen, gdg::Point &p) const;
+    // Dense scan lines in overlapping swaths, no returns from water
+    void makeSwathPoint(PhiloxRandGen &randGen, gdg::Point &p) const;
+};
+
+#endif //DELAUNAY_GENERATOR_SYNTHETICSCENE_H
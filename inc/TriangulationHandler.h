@@ -3,6 +3,10 @@
 
 #include "gpu-delaunay-generator.h"
 #include "InputGenerator.h"
+#include "include/CompactMesh.h"
+#include "include/GeojsonFile.h"
+#include "include/GlbFile.h"
+#include "include/ResultCache.h"
 #include <bits/stdc++.h>
 #include <iomanip>
 
@@ -70,25 +74,63 @@ inline bool isIntersect(line l1, line l2)
     return false;
 }
 
+namespace YAML
+{
+class Node;
+}
+
+// Options of the mesh writers, from the Output* config keys
+struct MeshOutputOption
+{
+    bool                   objColor = false;
+    gdg::GeojsonOption     geojson;
+    gdg::GlbOption         glb;
+    gdg::CompactMeshOption compact;
+
+    void readFromConfig(const YAML::Node &config);
+};
+
+// Write the mesh in the format given by the extension of filename
+// (.obj, .geojson, .ply, .glb or .gdc); throws if it cannot be written
+void saveMesh(const std::string      &filename,
+              const gdg::Input       &input,
+              const gdg::Output      &output,
+              const MeshOutputOption &option);
+
+// Open the cache named by ResultCacheDir, or return null if it is not set
+std::unique_ptr<gdg::ResultCache> openResultCache(const YAML::Node &config);
+
+void printResultCacheStats(const gdg::ResultCache &resultCache);
+
 class TriangulationHandler
 {
   private:
     TriangulationHandler() = default;
 
     void reset();
+    void check(int runIdx);
     void saveResultsToFile();
-    void saveToGeojson(std::ofstream &outputTri) const;
-    void saveToObj(std::ofstream &outputTri) const;
+    void saveStatsToFile(const gdg::StatisticsSummary &summary) const;
     bool checkInside(gdg::Tri &t, gdg::Point p) const;
 
     int         runNum       = 1;
+    int         warmupNum    = 0; // Untimed runs before the timed ones
     bool        doCheck      = false;
+    bool        checkSampled = false;
     bool        outputResult = false;
+    bool        meshLoaded   = false;
     std::string OutputFilename;
+    std::string snapshotFilename;
+    std::string statsFilename;
+
+    gdg::Input             input;
+    gdg::Output            output;
+    gdg::StatisticsHistory statHistory;
+
+    std::unique_ptr<gdg::ResultCache> resultCache; // Null without ResultCacheDir
 
-    gdg::Input       input;
-    gdg::Output      output;
-    gdg::Statistics  statSum;
+    gdg::SampleCheckOption sampleCheckOption;
+    MeshOutputOption       outputOption;
 
   public:
     explicit TriangulationHandler(const char *InputYAMLFile);
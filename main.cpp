@@ -1,4 +1,4 @@
-#include "inc/TriangulationHandler.h"
+#include "inc/BatchHandler.h"
 #include <unistd.h>
 
 int main(int argc, char *argv[])
@@ -33,6 +33,13 @@ int main(int argc, char *argv[])
         return -1;
     }
 
+    if (isBatchConfig(YAMLFile))
+    {
+        BatchHandler batch(YAMLFile);
+        batch.run();
+        return batch.failedNum() == 0 ? 0 : 1;
+    }
+
     TriangulationHandler app(YAMLFile);
     app.run();
 }
@@ -0,0 +1,410 @@
+#include "../inc/BatchHandler.h"
+#include "include/MappedFile.h"
+#include "include/PointFile.h"
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <yaml-cpp/yaml.h>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+// Unparsed files are sized by their shortest likely records, "x y z" text
+// lines or float PLY vertices, so their tiles are overestimated
+constexpr size_t FileBytesPerPoint      = 12;
+constexpr size_t FileBytesPerConstraint = 8;
+
+double elapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Points and constraints, plus about two triangles per point once computed
+size_t tileBytes(size_t pointNum, size_t constraintNum)
+{
+    return pointNum * (sizeof(gdg::Point) + 2 * (sizeof(gdg::Tri) + sizeof(gdg::TriOpp))) +
+           constraintNum * sizeof(gdg::Edge);
+}
+
+size_t fileSize(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    return file ? static_cast<size_t>(file.tellg()) : 0;
+}
+
+// Memory of a tile before it is parsed, from the point counts in LAS and .gdp
+// headers or else from the file sizes
+size_t estimateTileBytes(const BatchTile &tile)
+{
+    size_t pointNum = 0, constraintNum = 0;
+    try
+    {
+        char signature[4] = {};
+        std::ifstream(tile.inputFilename, std::ios::binary).read(signature, sizeof(signature));
+        if (std::memcmp(signature, "LASF", sizeof(signature)) == 0)
+        {
+            pointNum = gdg::LasReader(tile.inputFilename).header().pointNum;
+        }
+        else if (gdg::isPointFile(tile.inputFilename))
+        {
+            const gdg::MappedFile        file(tile.inputFilename);
+            const gdg::PointFileHeader &header = gdg::checkPointFileHeader(file.data(), file.size());
+            pointNum                           = header.pointNum;
+            constraintNum                      = header.constraintNum;
+        }
+    }
+    catch (const std::exception &)
+    {
+        // Reading the tile reports the error
+    }
+    if (pointNum == 0)
+        pointNum = fileSize(tile.inputFilename) / FileBytesPerPoint;
+    if (!tile.constraintFilename.empty())
+        constraintNum += fileSize(tile.constraintFilename) / FileBytesPerConstraint;
+    return tileBytes(pointNum, constraintNum);
+}
+}
+
+std::vector<BatchTile> readBatchManifest(const std::string &filename)
+{
+    std::ifstream manifest(filename);
+    if (!manifest.is_open())
+    {
+        throw std::invalid_argument("Batch manifest " + filename + " doesn't exist!");
+    }
+
+    std::vector<BatchTile> tiles;
+    std::string            line;
+    for (int lineIdx = 1; std::getline(manifest, line); ++lineIdx)
+    {
+        std::istringstream       words(line);
+        std::vector<std::string> fields;
+        for (std::string word; words >> word;)
+            fields.push_back(word);
+        if (fields.empty() || fields[0][0] == '#')
+            continue;
+
+        if (fields.size() == 2)
+        {
+            tiles.push_back({fields[0], "", fields[1]});
+        }
+        else if (fields.size() == 3)
+        {
+            tiles.push_back({fields[0], fields[1], fields[2]});
+        }
+        else
+        {
+            throw std::invalid_argument("Batch manifest " + filename + ":" + std::to_string(lineIdx) +
+                                        ": expected \"input [constraints] output\"");
+        }
+    }
+    return tiles;
+}
+
+bool isBatchConfig(const char *InputYAMLFile)
+{
+    YAML::Node config = YAML::LoadFile(InputYAMLFile);
+    return config["BatchManifest"] && !config["BatchManifest"].as<std::string>().empty();
+}
+
+BatchHandler::BatchHandler(const char *InputYAMLFile)
+{
+    deviceId = gdg::cutGetMaxGflopsDeviceId();
+    CudaSafeCall(cudaSetDevice(deviceId));
+
+    YAML::Node config = YAML::LoadFile(InputYAMLFile);
+
+    tiles = readBatchManifest(config["BatchManifest"].as<std::string>());
+    tileStats.resize(tiles.size());
+    if (config["BatchReaders"])
+        readerNum = std::max(1, config["BatchReaders"].as<int>());
+    if (config["BatchWriters"])
+        writerNum = std::max(1, config["BatchWriters"].as<int>());
+    if (config["BatchQueueSize"])
+        queueSize = std::max(1, config["BatchQueueSize"].as<int>());
+    if (config["BatchMemoryCapMB"])
+        memoryCap = config["BatchMemoryCapMB"].as<size_t>() << 20;
+    if (config["BatchStatsPath"])
+        statsFilename = config["BatchStatsPath"].as<std::string>();
+
+    if (config["LasClassifications"])
+    {
+        lasFilter.classifications = config["LasClassifications"].as<std::vector<int>>();
+        lasFilter.returnNumbers   = config["LasReturnNumbers"].as<std::vector<int>>();
+        lasFilter.lastReturnOnly  = config["LasLastReturnOnly"].as<bool>();
+    }
+    insAll    = config["InsertAll"].as<bool>();
+    noSort    = config["NoSortPoint"].as<bool>();
+    noReorder = config["NoReorder"].as<bool>();
+    outputOption.readFromConfig(config);
+    resultCache = openResultCache(config);
+}
+
+void BatchHandler::readStage()
+{
+    double busy = .0;
+    for (size_t i = nextTile++; i < tiles.size(); i = nextTile++)
+    {
+        const BatchTile &tile = tiles[i];
+        BatchTileStat   &stat = tileStats[i];
+
+        // Hold an estimate while the tile is parsed, so tiles being read stay
+        // under the cap too; it is corrected once the tile is read
+        const size_t estimate = estimateTileBytes(tile);
+        memoryBudget->acquire(estimate);
+        const auto start = Clock::now();
+
+        auto job     = std::make_unique<BatchJob>();
+        job->tileIdx = i;
+        try
+        {
+            InputGeneratorOption inputGeneratorOption;
+            inputGeneratorOption.inputFromFile           = true;
+            inputGeneratorOption.inputFilename           = tile.inputFilename;
+            inputGeneratorOption.inputConstraint         = !tile.constraintFilename.empty();
+            inputGeneratorOption.inputConstraintFilename = tile.constraintFilename;
+            inputGeneratorOption.lasFilter               = lasFilter;
+
+            gdg::Input &input = job->input;
+            InputGenerator(inputGeneratorOption, input).generateInput();
+            input.insAll    = insAll;
+            input.noSort    = noSort;
+            input.noReorder = noReorder;
+            if (input.pointNum() < 3)
+            {
+                throw std::runtime_error("Tile has fewer than 3 points");
+            }
+        }
+        catch (const std::exception &e)
+        {
+            stat.error = e.what();
+            busy += elapsedMs(start);
+            job.reset();
+            memoryBudget->release(estimate);
+            finishTile(i);
+            continue;
+        }
+        stat.pointNum = job->input.pointNum();
+        stat.readTime = elapsedMs(start);
+        busy += stat.readTime;
+
+        job->bytes = tileBytes(stat.pointNum, job->input.constraintNum());
+        memoryBudget->adjust(estimate, job->bytes);
+        readQueue->push(std::move(job));
+    }
+    addBusyTime(readBusy, busy);
+
+    if (++readerDoneNum == readerNum)
+        readQueue->close();
+}
+
+void BatchHandler::computeStage()
+{
+    gdg::GpuDel gpuDel;
+    gpuDel.setKeepBuffers(true);
+
+    double                    busy = .0;
+    std::unique_ptr<BatchJob> job;
+    while (readQueue->pop(job))
+    {
+        BatchTileStat &stat  = tileStats[job->tileIdx];
+        const auto     start = Clock::now();
+        gdg::ResultCacheKey cacheKey{};
+        try
+        {
+            if (resultCache)
+                cacheKey = gdg::makeResultCacheKey(job->input);
+            if (!resultCache || !resultCache->load(cacheKey, job->output))
+            {
+                gpuDel.compute(job->input, job->output);
+                if (resultCache)
+                    storeResult(cacheKey, job->output);
+            }
+        }
+        catch (const std::exception &e)
+        {
+            // Start the next tile from a clean state
+            gpuDel.releaseBuffers();
+            stat.error = e.what();
+            busy += elapsedMs(start);
+
+            const size_t tileIdx = job->tileIdx, bytes = job->bytes;
+            job.reset();
+            memoryBudget->release(bytes);
+            finishTile(tileIdx);
+            continue;
+        }
+        stat.triNum      = job->output.triNum();
+        stat.computeTime = elapsedMs(start);
+        busy += stat.computeTime;
+        writeQueue->push(std::move(job));
+    }
+    gpuDel.releaseBuffers();
+    addBusyTime(computeBusy, busy);
+
+    writeQueue->close();
+}
+
+void BatchHandler::storeResult(const gdg::ResultCacheKey &cacheKey, const gdg::Output &output)
+{
+    // A cache that cannot be written must not fail the tile
+    try
+    {
+        resultCache->store(cacheKey, output);
+    }
+    catch (const std::exception &e)
+    {
+        std::lock_guard<std::mutex> lock(logMutex);
+        std::cerr << e.what() << std::endl;
+    }
+}
+
+void BatchHandler::writeStage()
+{
+    double                    busy = .0;
+    std::unique_ptr<BatchJob> job;
+    while (writeQueue->pop(job))
+    {
+        const size_t   tileIdx = job->tileIdx, bytes = job->bytes;
+        BatchTileStat &stat    = tileStats[tileIdx];
+        const auto     start   = Clock::now();
+        try
+        {
+            saveMesh(tiles[tileIdx].outputFilename, job->input, job->output, outputOption);
+        }
+        catch (const std::exception &e)
+        {
+            stat.error = e.what();
+        }
+        job.reset();
+        stat.writeTime = elapsedMs(start);
+        busy += stat.writeTime;
+
+        memoryBudget->release(bytes);
+        finishTile(tileIdx);
+    }
+    addBusyTime(writeBusy, busy);
+}
+
+void BatchHandler::finishTile(size_t tileIdx)
+{
+    BatchTileStat &stat = tileStats[tileIdx];
+    stat.done           = true;
+
+    std::lock_guard<std::mutex> lock(logMutex);
+    std::cout << "[" << ++doneNum << "/" << tiles.size() << "] " << tiles[tileIdx].inputFilename;
+    if (stat.error.empty())
+        std::cout << ": " << stat.pointNum << " points, " << stat.triNum << " triangles, read/compute/write "
+                  << std::fixed << std::setprecision(2) << stat.readTime << "/" << stat.computeTime << "/"
+                  << stat.writeTime << " ms" << std::endl;
+    else
+        std::cout << ": FAILED: " << stat.error << std::endl;
+}
+
+void BatchHandler::addBusyTime(double &stageBusy, double time)
+{
+    std::lock_guard<std::mutex> lock(logMutex);
+    stageBusy += time;
+}
+
+void BatchHandler::run()
+{
+    readQueue    = std::make_unique<BoundedQueue<std::unique_ptr<BatchJob>>>(queueSize);
+    writeQueue   = std::make_unique<BoundedQueue<std::unique_ptr<BatchJob>>>(queueSize);
+    memoryBudget = std::make_unique<MemoryBudget>(memoryCap);
+
+    const auto start = Clock::now();
+
+    std::vector<std::thread> readers, writers;
+    for (int t = 0; t < readerNum; ++t)
+        readers.emplace_back(&BatchHandler::readStage, this);
+    for (int t = 0; t < writerNum; ++t)
+        writers.emplace_back(&BatchHandler::writeStage, this);
+
+    // The GPU stage runs on this thread, which holds the selected device
+    computeStage();
+
+    for (auto &reader : readers)
+        reader.join();
+    for (auto &writer : writers)
+        writer.join();
+
+    const double wallTime = elapsedMs(start) / 1000;
+
+    size_t pointSum = 0, triSum = 0;
+    for (const auto &stat : tileStats)
+    {
+        if (!stat.error.empty())
+            continue;
+        pointSum += stat.pointNum;
+        triSum += stat.triNum;
+    }
+
+    // Share of the wall time the threads of a stage were busy
+    auto utilization = [&](double busy, int threadNum) { return busy / (10 * wallTime * threadNum); };
+
+    std::cout << std::endl;
+    std::cout << "---- BATCH SUMMARY ----" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Tiles          " << tiles.size() << " (" << failedNum() << " failed)" << std::endl;
+    std::cout << "PointNum       " << pointSum << std::endl;
+    std::cout << "TriangleNum    " << triSum << std::endl;
+    std::cout << std::endl;
+    std::cout << std::fixed << std::right << std::setprecision(2);
+    std::cout << "Stage          busy (ms)  utilization" << std::endl;
+    std::cout << "Read x" << std::left << std::setw(9) << readerNum << std::right << std::setw(10) << readBusy
+              << std::setw(12) << utilization(readBusy, readerNum) << " %" << std::endl;
+    std::cout << "Compute x1     " << std::setw(10) << computeBusy << std::setw(12) << utilization(computeBusy, 1)
+              << " %" << std::endl;
+    std::cout << "Write x" << std::left << std::setw(8) << writerNum << std::right << std::setw(10) << writeBusy
+              << std::setw(12) << utilization(writeBusy, writerNum) << " %" << std::endl;
+    std::cout << std::endl;
+    std::cout << "WallTime (s)   " << std::setw(10) << wallTime << std::endl;
+    std::cout << "Tiles/s        " << std::setw(10) << (tiles.size() - failedNum()) / wallTime << std::endl;
+    std::cout << "Points/s       " << std::setw(10) << pointSum / wallTime << std::endl;
+    std::cout << std::endl;
+    if (resultCache)
+        printResultCacheStats(*resultCache);
+
+    if (!statsFilename.empty())
+        saveStats();
+}
+
+void BatchHandler::saveStats() const
+{
+    std::ofstream statsFile(statsFilename);
+    if (!statsFile.is_open())
+    {
+        std::cerr << "Batch stats path " << statsFilename << " is not valid! will not save..." << std::endl;
+        return;
+    }
+
+    statsFile << "input,constraints,output,status,points,triangles,read_ms,compute_ms,write_ms,error\n";
+    statsFile << std::fixed << std::setprecision(3);
+    for (size_t i = 0; i < tiles.size(); ++i)
+    {
+        const BatchTile     &tile = tiles[i];
+        const BatchTileStat &stat = tileStats[i];
+
+        // Quote the error text, doubling embedded quotes
+        std::string error;
+        for (char c : stat.error)
+        {
+            error += c;
+            if (c == '"')
+                error += c;
+        }
+        statsFile << tile.inputFilename << "," << tile.constraintFilename << "," << tile.outputFilename << ","
+                  << (stat.error.empty() ? "ok" : "failed") << "," << stat.pointNum << "," << stat.triNum << ","
+                  << stat.readTime << "," << stat.computeTime << "," << stat.writeTime << ",\"" << error << "\"\n";
+    }
+}
+
+size_t BatchHandler::failedNum() const
+{
+    size_t num = 0;
+    for (const auto &stat : tileStats)
+        num += stat.done && !stat.error.empty();
+    return num;
+}
@@ -0,0 +1,180 @@
+#include "../inc/ConstraintGenerator.h"
+#include "../inc/RandGen.h"
+#include <cmath>
+#include <unordered_map>
+
+namespace
+{
+const std::unordered_map<std::string, ConstraintShape> shapeMap{{"None", NoConstraintShape},
+                                                                {"Polygons", PolygonConstraintShape},
+                                                                {"Breaklines", BreaklineConstraintShape},
+                                                                {"Roads", RoadConstraintShape}};
+
+// Drawn from a stream no generated point uses
+constexpr uint64_t ConstraintStream = (uint64_t(1) << 63) | (uint64_t(1) << 62);
+
+constexpr int    MinHoleSides  = 8;   // Fewer sides leave no room for a hole
+constexpr double StreetJitter  = 0.2; // Crossing offset, in blocks; below 0.25 the grid stays planar
+constexpr double StreetKeepPct = 0.8;
+
+class ConstraintBuilder
+{
+  private:
+    gdg::Input &input;
+
+  public:
+    PhiloxRandGen randGen;
+
+    explicit ConstraintBuilder(gdg::Input &input) : input(input) {}
+
+    int addPoint(double x, double y)
+    {
+        input.pointVec.push_back(gdg::Point(x, y, 0.0));
+        return static_cast<int>(input.pointVec.size()) - 1;
+    }
+
+    void addEdge(int v0, int v1)
+    {
+        gdg::Edge edge;
+        edge._v[0] = v0;
+        edge._v[1] = v1;
+        input.constraintVec.push_back(edge);
+    }
+
+    // Closed ring around (cx, cy) with radii in [rMin, rMax). Vertices are in
+    // angle order with gaps under 180 degrees, so the ring is simple.
+    void addRing(double cx, double cy, double rMin, double rMax, int sides)
+    {
+        const int first = static_cast<int>(input.pointVec.size());
+        for (int k = 0; k < sides; ++k)
+        {
+            const double a = 2 * M_PI * (k + 0.25 + 0.5 * randGen.getNext()) / sides;
+            const double r = rMin + (rMax - rMin) * randGen.getNext();
+            addPoint(cx + r * std::cos(a), cy + r * std::sin(a));
+        }
+        for (int k = 0; k < sides; ++k)
+            addEdge(first + k, first + (k + 1) % sides);
+    }
+
+    // Straight run from v0 to v1 split into segmentNum collinear edges
+    void addRun(int v0, int v1, int segmentNum)
+    {
+        const gdg::Point p0   = input.pointVec[v0];
+        const gdg::Point p1   = input.pointVec[v1];
+        int              prev = v0;
+        for (int k = 1; k < segmentNum; ++k)
+        {
+            const double t   = double(k) / segmentNum;
+            const int    cur = addPoint(p0._p[0] + t * (p1._p[0] - p0._p[0]), p0._p[1] + t * (p1._p[1] - p0._p[1]));
+            addEdge(prev, cur);
+            prev = cur;
+        }
+        addEdge(prev, v1);
+    }
+};
+
+// Polygons sit in disjoint cells of a grid; a hole is smaller than the
+// distance from the center to every outer edge
+void makePolygons(ConstraintBuilder &builder, int constraintNum, int segmentNum)
+{
+    const int    sides     = std::max(3, segmentNum);
+    const int    holeSides = (sides >= MinHoleSides) ? sides / 2 : 0;
+    const int    polyNum   = std::max(1, (constraintNum + sides + holeSides - 1) / (sides + holeSides));
+    const int    gridSize  = static_cast<int>(std::ceil(std::sqrt(double(polyNum))));
+    const double cell      = 1.0 / gridSize;
+
+    for (int p = 0; p < polyNum; ++p)
+    {
+        const double cx = (p % gridSize + 0.5) * cell;
+        const double cy = (p / gridSize + 0.5) * cell;
+        builder.addRing(cx, cy, 0.3 * cell, 0.45 * cell, sides);
+        if (holeSides > 0)
+            builder.addRing(cx, cy, 0.08 * cell, 0.2 * cell, holeSides);
+    }
+}
+
+// Each breakline stays inside its own horizontal band and runs left to right
+void makeBreaklines(ConstraintBuilder &builder, int constraintNum, int segmentNum)
+{
+    const int    lineNum = std::max(1, (constraintNum + segmentNum - 1) / segmentNum);
+    const double band    = 1.0 / lineNum;
+
+    for (int l = 0; l < lineNum; ++l)
+    {
+        const double y    = (l + 0.5) * band;
+        int          prev = -1;
+        for (int k = 0; k <= segmentNum; ++k)
+        {
+            const double x   = 0.01 + 0.98 * k / segmentNum;
+            const int    cur = builder.addPoint(x, y + (builder.randGen.getNext() - 0.5) * 0.8 * band);
+            if (prev >= 0)
+                builder.addEdge(prev, cur);
+            prev = cur;
+        }
+    }
+}
+
+// Streets join neighbouring crossings of a jittered grid, some are left out
+void makeRoads(ConstraintBuilder &builder, int constraintNum, int segmentNum)
+{
+    const int    size  = std::max(2, static_cast<int>(std::sqrt(constraintNum / (2.0 * segmentNum * StreetKeepPct))));
+    const double block = 1.0 / size;
+
+    std::vector<int> crossing(size * size);
+    for (int j = 0; j < size; ++j)
+    {
+        for (int i = 0; i < size; ++i)
+        {
+            const double x         = (i + 0.5 + StreetJitter * (2 * builder.randGen.getNext() - 1)) * block;
+            const double y         = (j + 0.5 + StreetJitter * (2 * builder.randGen.getNext() - 1)) * block;
+            crossing[j * size + i] = builder.addPoint(x, y);
+        }
+    }
+
+    for (int j = 0; j < size; ++j)
+    {
+        for (int i = 0; i < size; ++i)
+        {
+            if (i + 1 < size && builder.randGen.getNext() < StreetKeepPct)
+                builder.addRun(crossing[j * size + i], crossing[j * size + i + 1], segmentNum);
+            if (j + 1 < size && builder.randGen.getNext() < StreetKeepPct)
+                builder.addRun(crossing[j * size + i], crossing[(j + 1) * size + i], segmentNum);
+        }
+    }
+}
+}
+
+void ConstraintGeneratorOption::setShapeFromStr(const std::string &shapeStr)
+{
+    if (shapeMap.find(shapeStr) == shapeMap.end())
+    {
+        throw std::invalid_argument("Input: cannot find the constraint type specified!");
+    }
+    shape = shapeMap.at(shapeStr);
+}
+
+void makeConstraints(const ConstraintGeneratorOption &option, int seed, gdg::Input &input)
+{
+    if (option.shape == NoConstraintShape || option.constraintNum <= 0)
+        return;
+
+    input.unmap();
+
+    ConstraintBuilder builder(input);
+    builder.randGen.init(seed, 0.0, 1.0);
+    builder.randGen.setStream(ConstraintStream);
+
+    const int segmentNum = std::max(1, option.segmentNum);
+    switch (option.shape)
+    {
+    case PolygonConstraintShape:
+        makePolygons(builder, option.constraintNum, segmentNum);
+        break;
+    case BreaklineConstraintShape:
+        makeBreaklines(builder, option.constraintNum, segmentNum);
+        break;
+    default:
+        makeRoads(builder, option.constraintNum, segmentNum);
+        break;
+    }
+}
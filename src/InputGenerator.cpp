@@ -1,10 +1,14 @@
 #include "../inc/InputGenerator.h"
+#include "include/HostParallel.h"
+#include "include/MappedFile.h"
+#include "include/PlyFile.h"
+#include "include/PointFile.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
 #include <cmath>
+#include <cstring>
 #include <unordered_map>
-#include <unordered_set>
-#ifdef WITH_PCL
-#include <pcl/io/pcd_io.h>
-#endif
 
 namespace
 {
@@ -15,29 +19,301 @@ const std::unordered_map<std::string, Distribution> distributionMap{{"Uniform",
                                                                     {"Circle", CircleDistribution},
                                                                     {"Grid", GridDistribution},
                                                                     {"Ellipse", EllipseDistribution},
-                                                                    {"TwoLines", TwoLineDistribution}};
+                                                                    {"TwoLines", TwoLineDistribution},
+                                                                    {"Terrain", TerrainDistribution},
+                                                                    {"Voids", VoidDistribution},
+                                                                    {"Clusters", ClusterDistribution},
+                                                                    {"Swath", SwathDistribution}};
+
+// Distributions drawn from a SyntheticScene
+bool isSceneDistribution(Distribution distribution)
+{
+    return distribution == TerrainDistribution || distribution == VoidDistribution ||
+           distribution == ClusterDistribution || distribution == SwathDistribution;
 }
 
-InputGenerator::InputGenerator(const InputGeneratorOption &InputPara, gdg::Input &Input) : option(InputPara), input(Input)
+bool hasExtension(const std::string &filename, const std::string &extension)
 {
+    if (filename.size() < extension.size())
+        return false;
+    return std::equal(extension.begin(), extension.end(), filename.end() - extension.size(), [](char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+    });
 }
 
-void InputGeneratorOption::setDistributionFromStr(const std::string &distributionStr)
+bool isPointFileName(const std::string &filename)
 {
-    if (distributionMap.find(distributionStr) == distributionMap.end())
+    return hasExtension(filename, ".gdp");
+}
+
+// LAZ files go to the LAS reader as well, which rejects their compressed data
+bool isLasFile(const std::string &filename)
+{
+    if (hasExtension(filename, ".las") || hasExtension(filename, ".laz"))
+        return true;
+    std::ifstream inFile(filename, std::ios::binary);
+    char          signature[4] = {};
+    inFile.read(signature, sizeof(signature));
+    return inFile && std::memcmp(signature, "LASF", sizeof(signature)) == 0;
+}
+
+bool isSeparator(char c)
+{
+    return c == ' ' || c == '\t' || c == ',' || c == '\r';
+}
+
+// A line holds data if it is not blank and not a comment
+bool isDataLine(const char *begin, const char *end)
+{
+    while (begin < end && isSeparator(*begin))
+        ++begin;
+    return begin < end && *begin != '#';
+}
+
+// Parse up to num values from the line, returns how many were read
+template <typename T>
+int parseLine(const char *begin, const char *end, T *val, int num)
+{
+    int i = 0;
+    while (i < num)
     {
-        throw std::invalid_argument("Input: cannot find the distribution specified!");
+        while (begin < end && (isSeparator(*begin) || *begin == '+'))
+            ++begin;
+
+        const auto ret = std::from_chars(begin, end, val[i]);
+        if (ret.ec != std::errc())
+            break;
+
+        begin = ret.ptr;
+        ++i;
     }
-    distribution = distributionMap.at(distributionStr);
+    return i;
 }
 
-void InputGenerator::randCirclePoint(double &x, double &y)
+// Call func(threadIdx, lineBegin, lineEnd) on every data line of the file.
+// Each thread takes the lines starting in its share of the bytes, so two
+// calls on the same file visit the same lines in the same threads.
+template <typename Func>
+void forEachDataLine(const gdg::MappedFile &file, Func func)
+{
+    const char  *data = file.data();
+    const size_t size = file.size();
+
+    gdg::parallelFor(size, [&](int t, size_t begin, size_t end) {
+        size_t pos = begin;
+
+        // The line crossing the start of the range belongs to the previous one
+        if (pos > 0 && data[pos - 1] != '\n')
+        {
+            const void *newLine = std::memchr(data + pos, '\n', size - pos);
+            pos                 = newLine ? static_cast<const char *>(newLine) - data + 1 : size;
+        }
+
+        while (pos < end)
+        {
+            const void  *newLine = std::memchr(data + pos, '\n', size - pos);
+            const size_t lineEnd = newLine ? static_cast<const char *>(newLine) - data : size;
+
+            if (isDataLine(data + pos, data + lineEnd))
+                func(t, data + pos, data + lineEnd);
+
+            pos = lineEnd + 1;
+        }
+    });
+}
+
+// Parse every data line of a text file into vec. Lines are counted first so
+// each thread writes its share of vec in place.
+template <typename T, typename Parse>
+void parseTextFile(const std::string &filename, thrust::host_vector<T> &vec, Parse parse)
+{
+    const gdg::MappedFile file(filename);
+
+    std::vector<size_t> lineOffset(gdg::parallelThreadNum(file.size()), 0);
+
+    forEachDataLine(file, [&](int t, const char *, const char *) { ++lineOffset[t]; });
+
+    size_t total = 0;
+    for (size_t &offset : lineOffset)
+    {
+        const size_t num = offset;
+        offset           = total;
+        total += num;
+    }
+
+    const size_t oldSize = vec.size();
+    vec.resize(oldSize + total);
+
+    forEachDataLine(
+        file, [&](int t, const char *begin, const char *end) { parse(begin, end, vec[oldSize + lineOffset[t]++]); });
+}
+
+// Draws from a RandGen through fillUniform(), in the order getNext() would
+// return them, so legacy inputs are reproduced faster
+class LegacyRandGen
+{
+  private:
+    RandGen             randGen;
+    std::vector<double> buffer;
+    size_t              pos;
+
+  public:
+    explicit LegacyRandGen(int seed) : buffer(1 << 16), pos(buffer.size())
+    {
+        randGen.init(seed, 0.0, 1.0);
+    }
+
+    double getNext()
+    {
+        if (pos == buffer.size())
+        {
+            randGen.fillUniform(buffer.data(), buffer.size());
+            pos = 0;
+        }
+        return buffer[pos++];
+    }
+
+    void nextGaussian(double &x, double &y)
+    {
+        polarGaussian([this] { return getNext(); }, x, y);
+        x = (x + 3.0) / 6.0;
+        y = (y + 3.0) / 6.0;
+    }
+};
+
+template <typename Gen>
+void randCirclePoint(Gen &randGen, double &x, double &y)
 {
     double a = randGen.getNext() * M_PI * 2;
     x        = 0.45 * cos(a);
     y        = 0.45 * sin(a);
 }
 
+// One point of each distribution, drawn from the current stream of randGen
+
+template <typename Gen>
+void makePointUniform(Gen &randGen, gdg::Point &p)
+{
+    p._p[0] = randGen.getNext();
+    p._p[1] = randGen.getNext();
+    p._p[2] = cos(p._p[0]);
+}
+
+template <typename Gen>
+void makePointGaussian(Gen &randGen, gdg::Point &p)
+{
+    randGen.nextGaussian(p._p[0], p._p[1]);
+    p._p[2] = cos(p._p[0]);
+}
+
+template <typename Gen>
+void makePointDisk(Gen &randGen, gdg::Point &p)
+{
+    double d;
+    do
+    {
+        p._p[0] = randGen.getNext() - 0.5;
+        p._p[1] = randGen.getNext() - 0.5;
+        d       = p._p[0] * p._p[0] + p._p[1] * p._p[1];
+    } while (d > 0.45 * 0.45);
+    p._p[0] += 0.5;
+    p._p[1] += 0.5;
+    p._p[2] = cos(p._p[0]);
+}
+
+template <typename Gen>
+void makePointThinCircle(Gen &randGen, gdg::Point &p)
+{
+    double d = randGen.getNext() * 0.001;
+    double a = randGen.getNext() * 3.141592654 * 2;
+    p._p[0]  = (0.45 + d) * cos(a) + 0.5;
+    p._p[1]  = (0.45 + d) * sin(a) + 0.5;
+    p._p[2]  = cos(p._p[0]);
+}
+
+template <typename Gen>
+void makePointCircle(Gen &randGen, gdg::Point &p)
+{
+    randCirclePoint(randGen, p._p[0], p._p[1]);
+    p._p[0] += 0.5;
+    p._p[1] += 0.5;
+    p._p[2] = cos(p._p[0]);
+}
+
+template <typename Gen>
+void makePointGrid(Gen &randGen, gdg::Point &p)
+{
+    double val  = randGen.getNext() * 8192;
+    double frac = val - floor(val);
+    p._p[0]     = ((frac < 0.5f) ? floor(val) : ceil(val)) / 8192;
+    val         = randGen.getNext() * 8192;
+    frac        = val - floor(val);
+    p._p[1]     = ((frac < 0.5f) ? floor(val) : ceil(val)) / 8192;
+    p._p[2]     = cos(p._p[0]);
+}
+
+template <typename Gen>
+void makePointEllipse(Gen &randGen, gdg::Point &p)
+{
+    randCirclePoint(randGen, p._p[0], p._p[1]);
+    p._p[0] = p._p[0] * 1.0 / 3.0 + 0.5;
+    p._p[1] = p._p[1] * 2.0 / 3.0 + 0.5;
+    p._p[2] = cos(p._p[0]);
+}
+
+template <typename Gen>
+void makePointTwoLine(Gen &randGen, gdg::Point &p)
+{
+    const gdg::Point L[2][2] = {{{0.0, 0.0, 0.0}, {0.3, 0.5, 0.0}}, {{0.7, 0.5, 0.0}, {1.0, 1.0, 0.0}}};
+
+    int    l = (randGen.getNext() < 0.5) ? 0 : 1;
+    double t = randGen.getNext();
+    p._p[0]  = (L[l][1]._p[0] - L[l][0]._p[0]) * t + L[l][0]._p[0];
+    p._p[1]  = (L[l][1]._p[1] - L[l][0]._p[1]) * t + L[l][0]._p[1];
+    p._p[2]  = cos(p._p[0]);
+}
+
+template <typename Gen>
+using MakePointFunc = void (*)(Gen &, gdg::Point &);
+
+template <typename Gen>
+MakePointFunc<Gen> makePointFunc(Distribution distribution)
+{
+    switch (distribution)
+    {
+    case GaussianDistribution:
+        return makePointGaussian<Gen>;
+    case DiskDistribution:
+        return makePointDisk<Gen>;
+    case ThinCircleDistribution:
+        return makePointThinCircle<Gen>;
+    case CircleDistribution:
+        return makePointCircle<Gen>;
+    case GridDistribution:
+        return makePointGrid<Gen>;
+    case EllipseDistribution:
+        return makePointEllipse<Gen>;
+    case TwoLineDistribution:
+        return makePointTwoLine<Gen>;
+    default:
+        return makePointUniform<Gen>;
+    }
+}
+}
+
+InputGenerator::InputGenerator(const InputGeneratorOption &InputPara, gdg::Input &Input) : option(InputPara), input(Input)
+{
+}
+
+void InputGeneratorOption::setDistributionFromStr(const std::string &distributionStr)
+{
+    if (distributionMap.find(distributionStr) == distributionMap.end())
+    {
+        throw std::invalid_argument("Input: cannot find the distribution specified!");
+    }
+    distribution = distributionMap.at(distributionStr);
+}
+
 void InputGenerator::generateInput()
 {
     if (option.inputFromFile)
@@ -51,17 +327,30 @@ void InputGenerator::generateInput()
     else
     {
         makePoints();
-        input.removeDuplicates();
+        if (option.constraintOption.shape != NoConstraintShape)
+        {
+            makeConstraints(option.constraintOption, option.seed, input);
+            input.removeDuplicates();
+        }
     }
 
-    if (option.saveToFile)
+    if (option.saveToFile && isPointFileName(option.saveFilename))
+    {
+        gdg::writePointFile(option.saveFilename,
+                            input.points(),
+                            input.pointNum(),
+                            input.constraints(),
+                            input.constraintNum());
+    }
+    else if (option.saveToFile)
     {
         std::ofstream outputPoint(option.saveFilename);
         if (outputPoint.is_open())
         {
             outputPoint << std::setprecision(12);
-            for (const auto &pt : input.pointVec)
+            for (size_t i = 0; i < input.pointNum(); ++i)
             {
+                const gdg::Point &pt = input.points()[i];
                 outputPoint << pt._p[0] << " " << pt._p[1] << " " << pt._p[2] << std::endl;
             }
             outputPoint.close();
@@ -71,15 +360,16 @@ void InputGenerator::generateInput()
             std::cerr << "Point saving path " << option.saveFilename << "is not valid! will not save..." << std::endl;
         }
 
-        if (option.inputConstraint)
+        if (input.constraintNum() > 0)
         {
             std::ofstream outputConstraint(option.saveFilename.substr(0, option.saveFilename.size() - 4) +
                                            "_constraints.txt");
             if (outputConstraint.is_open())
             {
                 outputConstraint << std::setprecision(12);
-                for (const auto &edge : input.constraintVec)
+                for (size_t i = 0; i < input.constraintNum(); ++i)
                 {
+                    const gdg::Edge &edge = input.constraints()[i];
                     outputConstraint << edge._v[0] << " " << edge._v[1] << std::endl;
                 }
                 outputConstraint.close();
@@ -87,242 +377,116 @@ void InputGenerator::generateInput()
         }
     }
 
-    std::cout << "Number of input points:      " << input.pointVec.size() << std::endl;
-    std::cout << "Number of input constraints: " << input.constraintVec.size() << std::endl;
+    std::cout << "Number of input points:      " << input.pointNum() << std::endl;
+    std::cout << "Number of input constraints: " << input.constraintNum() << std::endl;
 }
 
 void InputGenerator::makePoints()
 {
-    input.pointVec.reserve(option.pointNum);
-    randGen.init(option.seed, 0.0, 1.0);
-
-    switch (option.distribution)
-    {
-    case UniformDistribution:
-        makePointsUniform();
-        break;
-    case GaussianDistribution:
-        makePointsGaussian();
-        break;
-    case DiskDistribution:
-        makePointsDisk();
-        break;
-    case ThinCircleDistribution:
-        makePointsThinCircle();
-        break;
-    case CircleDistribution:
-        makePointsCircle();
-        break;
-    case GridDistribution:
-        makePointsGrid();
-        break;
-    case EllipseDistribution:
-        makePointsEllipse();
-        break;
-    case TwoLineDistribution:
-        makePointsTwoLine();
-        break;
-    default:
-        makePointsUniform();
-        break;
-    }
-}
-
-void InputGenerator::makePointsUniform()
-{
-    std::unordered_set<gdg::Point, gdg::PointHash> pointSet;
+    const size_t pointNum = static_cast<size_t>(std::max(option.pointNum, 0));
 
-    gdg::Point p;
-    while (pointSet.size() < option.pointNum)
+    if (option.legacyRandom && !isSceneDistribution(option.distribution))
     {
-        p._p[0] = randGen.getNext();
-        p._p[1] = randGen.getNext();
-        p._p[2] = cos(p._p[0]);
-        if (pointSet.find(p) == pointSet.end())
+        // Points drawn one after the other from a single sequence, as before
+        // the counter-based streams; a duplicate is replaced by the next point
+        LegacyRandGen randGen(option.seed);
+        const auto    makePoint = makePointFunc<LegacyRandGen>(option.distribution);
+        while (input.pointVec.size() < pointNum)
         {
-            pointSet.insert(p);
-            input.pointVec.push_back(p);
-        }
-    }
-}
+            const size_t oldNum = input.pointVec.size();
+            input.pointVec.resize(pointNum);
+            for (size_t i = oldNum; i < pointNum; ++i)
+                makePoint(randGen, input.pointVec[i]);
 
-void InputGenerator::makePointsGaussian()
-{
-    std::unordered_set<gdg::Point, gdg::PointHash> pointSet;
-    gdg::Point                                p;
-    while (pointSet.size() < option.pointNum)
-    {
-        randGen.nextGaussian(p._p[0], p._p[1]);
-        p._p[2] = cos(p._p[0]);
-        if (pointSet.find(p) == pointSet.end())
-        {
-            pointSet.insert(p);
-            input.pointVec.push_back(p);
+            input.removeDuplicates();
         }
+        return;
     }
-}
 
-void InputGenerator::makePointsDisk()
-{
-    std::unordered_set<gdg::Point, gdg::PointHash> pointSet;
-    gdg::Point                                p;
-    while (pointSet.size() < option.pointNum)
+    if (isSceneDistribution(option.distribution))
     {
-        double d;
-        do
-        {
-            p._p[0] = randGen.getNext() - 0.5;
-            p._p[1] = randGen.getNext() - 0.5;
-            d       = p._p[0] * p._p[0] + p._p[1] * p._p[1];
-        } while (d > 0.45 * 0.45);
-        p._p[0] += 0.5;
-        p._p[1] += 0.5;
-        p._p[2] = cos(p._p[0]);
-        if (pointSet.find(p) == pointSet.end())
-        {
-            pointSet.insert(p);
-            input.pointVec.push_back(p);
-        }
-    }
-}
+        const SyntheticScene scene(option.seed, pointNum);
 
-void InputGenerator::makePointsThinCircle()
-{
-    std::unordered_set<gdg::Point, gdg::PointHash> pointSet;
-    gdg::Point                                p;
-    while (pointSet.size() < option.pointNum)
-    {
-        double d = randGen.getNext() * 0.001;
-        double a = randGen.getNext() * 3.141592654 * 2;
-        p._p[0]  = (0.45 + d) * cos(a) + 0.5;
-        p._p[1]  = (0.45 + d) * sin(a) + 0.5;
-        p._p[2]  = cos(p._p[0]);
-        if (pointSet.find(p) == pointSet.end())
+        void (SyntheticScene::*makeScenePoint)(PhiloxRandGen &, gdg::Point &) const;
+        switch (option.distribution)
         {
-            pointSet.insert(p);
-            input.pointVec.push_back(p);
+        case VoidDistribution:
+            makeScenePoint = &SyntheticScene::makeVoidPoint;
+            break;
+        case ClusterDistribution:
+            makeScenePoint = &SyntheticScene::makeClusterPoint;
+            break;
+        case SwathDistribution:
+            makeScenePoint = &SyntheticScene::makeSwathPoint;
+            break;
+        default:
+            makeScenePoint = &SyntheticScene::makeTerrainPoint;
+            break;
         }
-    }
-}
 
-void InputGenerator::makePointsCircle()
-{
-    std::unordered_set<gdg::Point, gdg::PointHash> pointSet;
-    gdg::Point                                p;
-    while (pointSet.size() < option.pointNum)
-    {
-        randCirclePoint(p._p[0], p._p[1]);
-        p._p[0] += 0.5;
-        p._p[1] += 0.5;
-        p._p[2] = cos(p._p[0]);
-        if (pointSet.find(p) == pointSet.end())
-        {
-            pointSet.insert(p);
-            input.pointVec.push_back(p);
-        }
+        makeStreamPoints(pointNum,
+                         [&](PhiloxRandGen &randGen, gdg::Point &p) { (scene.*makeScenePoint)(randGen, p); });
+        return;
     }
-}
 
-void InputGenerator::makePointsGrid()
-{
-    std::unordered_set<gdg::Point, gdg::PointHash> pointSet;
-    gdg::Point                                p;
-    while (pointSet.size() < option.pointNum)
-    {
-
-        double val  = randGen.getNext() * 8192;
-        double frac = val - floor(val);
-        p._p[0]     = ((frac < 0.5f) ? floor(val) : ceil(val)) / 8192;
-        val         = randGen.getNext() * 8192;
-        frac        = val - floor(val);
-        p._p[1]     = ((frac < 0.5f) ? floor(val) : ceil(val)) / 8192;
-        p._p[2]     = cos(p._p[0]);
-        if (pointSet.find(p) == pointSet.end())
-        {
-            pointSet.insert(p);
-            input.pointVec.push_back(p);
-        }
-    }
+    makeStreamPoints(pointNum, makePointFunc<PhiloxRandGen>(option.distribution));
 }
 
-void InputGenerator::makePointsEllipse()
+template <typename MakePoint>
+void InputGenerator::makeStreamPoints(size_t pointNum, MakePoint makePoint)
 {
-    std::unordered_set<gdg::Point, gdg::PointHash> pointSet;
-    gdg::Point                                p;
-    while (pointSet.size() < option.pointNum)
+    // Point k drawn so far comes from stream k, so the points do not depend
+    // on the thread count. Duplicates are removed after each round and
+    // replaced by points from new streams.
+    uint64_t generated = 0;
+    while (input.pointVec.size() < pointNum)
     {
-        randCirclePoint(p._p[0], p._p[1]);
-        p._p[0] = p._p[0] * 1.0 / 3.0 + 0.5;
-        p._p[1] = p._p[1] * 2.0 / 3.0 + 0.5;
-        p._p[2] = cos(p._p[0]);
-        if (pointSet.find(p) == pointSet.end())
-        {
-            pointSet.insert(p);
-            input.pointVec.push_back(p);
-        }
-    }
-}
+        const size_t oldNum = input.pointVec.size();
+        const size_t newNum = pointNum - oldNum;
+        input.pointVec.resize(pointNum);
 
-void InputGenerator::makePointsTwoLine()
-{
-    std::unordered_set<gdg::Point, gdg::PointHash> pointSet;
-    gdg::Point                                p;
+        gdg::parallelFor(newNum, [&](int, size_t begin, size_t end) {
+            PhiloxRandGen randGen;
+            randGen.init(option.seed, 0.0, 1.0);
+            for (size_t i = begin; i < end; ++i)
+            {
+                randGen.setStream(generated + i);
+                makePoint(randGen, input.pointVec[oldNum + i]);
+            }
+        });
+        generated += newNum;
 
-    const gdg::Point L[2][2] = {{{0.0, 0.0, 0.0}, {0.3, 0.5, 0.0}}, {{0.7, 0.5, 0.0}, {1.0, 1.0, 0.0}}};
-    while (pointSet.size() < option.pointNum)
-    {
-        int    l = (randGen.getNext() < 0.5) ? 0 : 1;
-        double t = randGen.getNext();
-        p._p[0]  = (L[l][1]._p[0] - L[l][0]._p[0]) * t + L[l][0]._p[0];
-        p._p[1]  = (L[l][1]._p[1] - L[l][0]._p[1]) * t + L[l][0]._p[1];
-        p._p[2]  = cos(p._p[0]);
-        if (pointSet.find(p) == pointSet.end())
-        {
-            pointSet.insert(p);
-            input.pointVec.push_back(p);
-        }
+        input.removeDuplicates();
     }
 }
 
 void InputGenerator::readPoints()
 {
-#ifdef WITH_PCL
-    if (inFilename.substr(inFilename.size() - 4, 4) == ".pcd")
+    if (isLasFile(option.inputFilename))
     {
-        pcl::PointCloud<POINT_TYPE> inputPointCloud;
-        pcl::io::loadPCDFile(inFilename, inputPointCloud);
-        for (auto &pt : inputPointCloud)
-        {
-            input.pointVec.push_back({pt.x, pt.y, pt.z});
-        }
-        return input.pointVec;
+        gdg::LasReader reader(option.inputFilename, option.lasFilter);
+        reader.read(input.pointVec);
+        return;
     }
-#endif
-    std::ifstream inFile(option.inputFilename);
-    std::string   LineData;
-    gdg::Point         pt;
-    while (std::getline(inFile, LineData))
+    if (hasExtension(option.inputFilename, ".ply"))
     {
-        std::stringstream ss(LineData);
-        int i=0;
-        while(ss >> pt._p[i]){
-            ++i;
-        }
-        input.pointVec.push_back(pt);
+        gdg::readPlyPoints(option.inputFilename, input.pointVec);
+        return;
     }
-    inFile.close();
+    if (gdg::isPointFile(option.inputFilename))
+    {
+        // A constraint file given separately replaces the constraints stored in the point file
+        input.mapFromFile(option.inputFilename, !option.inputConstraint);
+        return;
+    }
+    parseTextFile(option.inputFilename, input.pointVec, [](const char *begin, const char *end, gdg::Point &pt) {
+        parseLine(begin, end, pt._p, 3);
+    });
 }
 
 void InputGenerator::readConstraints()
 {
-    std::ifstream inFile(option.inputConstraintFilename);
-    std::string   LineData;
-    gdg::Edge          edge;
-    while (std::getline(inFile, LineData))
-    {
-        std::stringstream ss(LineData);
-        ss >> edge._v[0] >> edge._v[1];
-        input.constraintVec.push_back(edge);
-    }
-    inFile.close();
-}
\ No newline at end of file
+    parseTextFile(option.inputConstraintFilename,
+                  input.constraintVec,
+                  [](const char *begin, const char *end, gdg::Edge &edge) { parseLine(begin, end, edge._v, 2); });
+}
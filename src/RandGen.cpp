@@ -3,6 +3,140 @@
 #include "../inc/RandGen.h"
 #include <climits>
 #include <cmath>
+#include <cstring>
+
+namespace
+{
+constexpr int    RandGenLanes        = 8;
+constexpr size_t RandGenMinLaneChunk = 256; // Shorter runs are not worth the jump
+
+constexpr unsigned long ZMul = 36969;
+constexpr unsigned long WMul = 18000;
+constexpr unsigned long CMul = 69069;
+constexpr unsigned long CAdd = 1234567;
+
+// A multiply-with-carry step maps the state S to S * a mod (a * 2^16 - 1)
+// once S is below the modulus
+constexpr uint64_t ZMod = ZMul * 65536 - 1;
+constexpr uint64_t WMod = WMul * 65536 - 1;
+
+uint64_t powMod(uint64_t base, size_t exp, uint64_t mod)
+{
+    uint64_t result = 1;
+    base %= mod;
+    for (; exp > 0; exp >>= 1)
+    {
+        if (exp & 1)
+            result = result * base % mod;
+        base = base * base % mod;
+    }
+    return result;
+}
+
+// Same as (double)r, without the unsigned 64-bit conversion that does not
+// vectorize: both 32-bit halves convert exactly and the sum rounds once
+inline double toDouble(unsigned long r)
+{
+    if constexpr (sizeof(r) < sizeof(uint64_t))
+    {
+        return (double)r;
+    }
+    else
+    {
+        const uint64_t hiBits = 0x4530000000000000ULL | (static_cast<uint64_t>(r) >> 32); // 2^84 + hi * 2^32
+        const uint64_t loBits = 0x4330000000000000ULL | (static_cast<uint64_t>(r) & 0xffffffffULL); // 2^52 + lo
+        double         hi, lo;
+        std::memcpy(&hi, &hiBits, sizeof(hi));
+        std::memcpy(&lo, &loBits, sizeof(lo));
+        return (hi - 19342813118337666422669312.0) + lo; // 2^84 + 2^52
+    }
+}
+
+// x -> mul * x + add, wrapping like unsigned long
+struct AffineMap
+{
+    unsigned long mul = 1;
+    unsigned long add = 0;
+
+    AffineMap then(const AffineMap &next) const
+    {
+        return {next.mul * mul, next.mul * add + next.add};
+    }
+
+    AffineMap pow(size_t exp) const
+    {
+        AffineMap result, base = *this;
+        for (; exp > 0; exp >>= 1)
+        {
+            if (exp & 1)
+                result = result.then(base);
+            base = base.then(base);
+        }
+        return result;
+    }
+};
+
+// SHR3 is linear over GF(2); col[j] is the image of bit j
+struct BitMatrix
+{
+    static constexpr int Bits = sizeof(unsigned long) * CHAR_BIT;
+
+    unsigned long col[Bits];
+
+    static BitMatrix identity()
+    {
+        BitMatrix m;
+        for (int j = 0; j < Bits; ++j)
+            m.col[j] = 1ul << j;
+        return m;
+    }
+
+    static BitMatrix shr3()
+    {
+        BitMatrix m;
+        for (int j = 0; j < Bits; ++j)
+        {
+            unsigned long v = 1ul << j;
+            v ^= (v << 17);
+            v ^= (v >> 13);
+            v ^= (v << 5);
+            m.col[j] = v;
+        }
+        return m;
+    }
+
+    unsigned long apply(unsigned long v) const
+    {
+        unsigned long result = 0;
+        for (int j = 0; v != 0; ++j, v >>= 1)
+        {
+            if (v & 1)
+                result ^= col[j];
+        }
+        return result;
+    }
+
+    BitMatrix then(const BitMatrix &next) const
+    {
+        BitMatrix m;
+        for (int j = 0; j < Bits; ++j)
+            m.col[j] = next.apply(col[j]);
+        return m;
+    }
+
+    BitMatrix pow(size_t exp) const
+    {
+        BitMatrix result = identity(), base = *this;
+        for (; exp > 0; exp >>= 1)
+        {
+            if (exp & 1)
+                result = result.then(base);
+            base = base.then(base);
+        }
+        return result;
+    }
+};
+}
 
 void RandGen::init(int seed, double minVal, double maxVal)
 {
@@ -18,12 +152,12 @@ void RandGen::init(int seed, double minVal, double maxVal)
 
 unsigned long RandGen::znew()
 {
-    return (_z = 36969 * (_z & 0xfffful) + (_z >> 16));
+    return (_z = ZMul * (_z & 0xfffful) + (_z >> 16));
 }
 
 unsigned long RandGen::wnew()
 {
-    return (_w = 18000 * (_w & 0xfffful) + (_w >> 16));
+    return (_w = WMul * (_w & 0xfffful) + (_w >> 16));
 }
 
 unsigned long RandGen::MWC()
@@ -40,7 +174,7 @@ unsigned long RandGen::SHR3()
 
 unsigned long RandGen::CONG()
 {
-    return (_jcong = 69069 * _jcong + 1234567);
+    return (_jcong = CMul * _jcong + CAdd);
 }
 
 unsigned long RandGen::rand_int() // [0,2^32-1]
@@ -59,25 +193,147 @@ double RandGen::getNext()
     return val;
 }
 
+void RandGen::fillUniform(double *out, size_t n)
+{
+    // Jumping needs the multiply-with-carry states below their moduli, which
+    // holds after the first steps from any seed
+    while (n > 0 && (_z >= ZMod || _w >= WMod))
+    {
+        *out++ = getNext();
+        --n;
+    }
+
+    const size_t chunk = n / RandGenLanes;
+    if (chunk >= RandGenMinLaneChunk)
+    {
+        const uint64_t  zJump     = powMod(ZMul, chunk, ZMod);
+        const uint64_t  wJump     = powMod(WMul, chunk, WMod);
+        const BitMatrix jsrJump   = BitMatrix::shr3().pow(chunk);
+        const AffineMap jcongJump = AffineMap{CMul, CAdd}.pow(chunk);
+
+        // Lane l produces values [l * chunk, (l + 1) * chunk)
+        unsigned long z[RandGenLanes], w[RandGenLanes], jsr[RandGenLanes], jcong[RandGenLanes];
+        z[0]     = _z;
+        w[0]     = _w;
+        jsr[0]   = _jsr;
+        jcong[0] = _jcong;
+        for (int l = 1; l < RandGenLanes; ++l)
+        {
+            z[l]     = static_cast<unsigned long>(z[l - 1] * zJump % ZMod);
+            w[l]     = static_cast<unsigned long>(w[l - 1] * wJump % WMod);
+            jsr[l]   = jsrJump.apply(jsr[l - 1]);
+            jcong[l] = jcongJump.mul * jcong[l - 1] + jcongJump.add;
+        }
+
+        const double scale = _max - _min;
+        for (size_t i = 0; i < chunk; ++i)
+        {
+            double val[RandGenLanes];
+            for (int l = 0; l < RandGenLanes; ++l)
+            {
+                z[l] = ZMul * (z[l] & 0xfffful) + (z[l] >> 16);
+                w[l] = WMul * (w[l] & 0xfffful) + (w[l] >> 16);
+                jsr[l] ^= (jsr[l] << 17);
+                jsr[l] ^= (jsr[l] >> 13);
+                jsr[l] ^= (jsr[l] << 5);
+                jcong[l] = CMul * jcong[l] + CAdd;
+
+                const unsigned long r = (((z[l] << 16) + w[l]) ^ jcong[l]) + jsr[l];
+                val[l]                = _min + scale * (toDouble(r) / (double(ULONG_MAX) + 1));
+            }
+            for (int l = 0; l < RandGenLanes; ++l)
+                out[l * chunk + i] = val[l];
+        }
+
+        // The last lane ends where the whole run ends
+        _z     = z[RandGenLanes - 1];
+        _w     = w[RandGenLanes - 1];
+        _jsr   = jsr[RandGenLanes - 1];
+        _jcong = jcong[RandGenLanes - 1];
+        out += chunk * RandGenLanes;
+        n -= chunk * RandGenLanes;
+    }
+
+    for (size_t i = 0; i < n; ++i)
+        out[i] = getNext();
+}
+
 void RandGen::nextGaussian(double &x, double &y)
 {
-    double x1, x2, w;
     double tx, ty;
+    polarGaussian([this] { return random(); }, tx, ty);
+
+    x = _min + (_max - _min) * ((tx + 3.0) / 6.0);
+    y = _min + (_max - _min) * ((ty + 3.0) / 6.0);
+}
+
+void PhiloxRandGen::init(int seed, double minVal, double maxVal)
+{
+    _min    = minVal;
+    _max    = maxVal;
+    _key[0] = static_cast<uint32_t>(seed);
+    _key[1] = 0x5eed5eed;
+    setStream(0);
+}
 
-    do
+void PhiloxRandGen::setStream(uint64_t stream)
+{
+    _stream  = stream;
+    _counter = 0;
+    _bufPos  = 4;
+}
+
+void PhiloxRandGen::refill()
+{
+    constexpr uint64_t M0 = 0xD2511F53;
+    constexpr uint64_t M1 = 0xCD9E8D57;
+    constexpr uint32_t W0 = 0x9E3779B9;
+    constexpr uint32_t W1 = 0xBB67AE85;
+
+    uint32_t c[4] = {static_cast<uint32_t>(_counter),
+                     static_cast<uint32_t>(_counter >> 32),
+                     static_cast<uint32_t>(_stream),
+                     static_cast<uint32_t>(_stream >> 32)};
+    uint32_t k[2] = {_key[0], _key[1]};
+
+    for (int round = 0; round < 10; ++round)
     {
-        do
-        {
-            x1 = 2.0 * random() - 1.0;
-            x2 = 2.0 * random() - 1.0;
-            w  = x1 * x1 + x2 * x2;
-        } while (w >= 1.0);
+        const uint64_t p0 = M0 * c[0];
+        const uint64_t p1 = M1 * c[2];
 
-        w  = sqrt((-2.0 * log(w)) / w);
-        tx = x1 * w;
-        ty = x2 * w;
-    } while (tx < -3 || tx >= 3 || ty < -3 || ty >= 3);
+        c[0] = static_cast<uint32_t>(p1 >> 32) ^ c[1] ^ k[0];
+        c[1] = static_cast<uint32_t>(p1);
+        c[2] = static_cast<uint32_t>(p0 >> 32) ^ c[3] ^ k[1];
+        c[3] = static_cast<uint32_t>(p0);
+        k[0] += W0;
+        k[1] += W1;
+    }
+
+    for (int i = 0; i < 4; ++i)
+        _buf[i] = c[i];
+    _bufPos = 0;
+    ++_counter;
+}
+
+double PhiloxRandGen::random() // [0,1), 53 bits
+{
+    if (_bufPos == 4)
+        refill();
+    const uint64_t bits = (static_cast<uint64_t>(_buf[_bufPos]) << 32) | _buf[_bufPos + 1];
+    _bufPos += 2;
+    return static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0);
+}
+
+double PhiloxRandGen::getNext()
+{
+    return _min + (_max - _min) * random();
+}
+
+void PhiloxRandGen::nextGaussian(double &x, double &y)
+{
+    double tx, ty;
+    polarGaussian([this] { return random(); }, tx, ty);
 
     x = _min + (_max - _min) * ((tx + 3.0) / 6.0);
     y = _min + (_max - _min) * ((ty + 3.0) / 6.0);
-}
\ No newline at end of file
+}
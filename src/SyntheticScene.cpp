@@ -0,0 +1,203 @@
+#include "../inc/SyntheticScene.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Scene layout is drawn from streams far above those of the points
+constexpr uint64_t SceneStream = uint64_t(1) << 63;
+
+constexpr double NoiseFrequency = 4.0;
+constexpr int    NoiseOctaves   = 6;
+constexpr double TerrainRelief  = 0.2;   // Height range relative to the square
+constexpr double WaterLevel     = -0.15; // Terrain below this is a lake
+constexpr double CanopyHeight   = 0.02;
+
+constexpr int    ClusterNum  = 512;
+constexpr double GroundShare = 0.25; // Cluster distribution points that hit the ground
+
+constexpr int    SwathNum     = 6;
+constexpr double SwathOverlap = 0.3; // Share of a swath's width covered by its neighbour
+constexpr double ScanSkew     = 0.3; // Along-track drift over a scan line, in line spacings
+constexpr double ScanJitter   = 0.02;
+
+// Swaths are spaced 1 / swathNum apart, so this width makes neighbours
+// share SwathOverlap of it
+double swathWidth(int swathNum)
+{
+    return 1.0 / (swathNum * (1.0 - SwathOverlap));
+}
+
+double fade(double t)
+{
+    return t * t * t * (t * (t * 6 - 15) + 10);
+}
+
+double lerp(double t, double a, double b)
+{
+    return a + t * (b - a);
+}
+
+// Dot product with one of eight lattice gradients
+double grad(int hash, double x, double y)
+{
+    switch (hash & 7)
+    {
+    case 0:
+        return x + y;
+    case 1:
+        return x - y;
+    case 2:
+        return -x + y;
+    case 3:
+        return -x - y;
+    case 4:
+        return x;
+    case 5:
+        return -x;
+    case 6:
+        return y;
+    default:
+        return -y;
+    }
+}
+}
+
+SyntheticScene::SyntheticScene(int seed, size_t pointNum)
+{
+    PhiloxRandGen randGen;
+    randGen.init(seed, 0.0, 1.0);
+
+    randGen.setStream(SceneStream);
+    for (int i = 0; i < 256; ++i)
+        perm[i] = i;
+    for (int i = 255; i > 0; --i)
+        std::swap(perm[i], perm[static_cast<int>(randGen.getNext() * (i + 1))]);
+    for (int i = 0; i < 256; ++i)
+        perm[256 + i] = perm[i];
+
+    randGen.setStream(SceneStream + 1);
+    clusters.resize(ClusterNum);
+    double weightSum = 0;
+    for (Cluster &cluster : clusters)
+    {
+        do
+        {
+            cluster.x = randGen.getNext();
+            cluster.y = randGen.getNext();
+        } while (!isLand(cluster.x, cluster.y));
+        const double size = randGen.getNext();
+        cluster.sigma     = 0.002 + 0.01 * size * size;
+        weightSum += randGen.getNext();
+        cluster.weight = weightSum;
+    }
+    for (Cluster &cluster : clusters)
+        cluster.weight /= weightSum;
+    clusters.back().weight = 1.0;
+
+    // Scan lines are spaced so points along a line are four times denser
+    // than the lines
+    swathNum = SwathNum;
+    lineNum  = std::max(1, static_cast<int>(std::sqrt(pointNum / (4.0 * SwathNum * swathWidth(SwathNum)))));
+}
+
+double SyntheticScene::noise(double x, double y) const
+{
+    const double fx = std::floor(x);
+    const double fy = std::floor(y);
+    const int    X  = static_cast<int>(fx) & 255;
+    const int    Y  = static_cast<int>(fy) & 255;
+    x -= fx;
+    y -= fy;
+
+    const double u  = fade(x);
+    const double v  = fade(y);
+    const int    A  = perm[X] + Y;
+    const int    B  = perm[X + 1] + Y;
+    const double n0 = lerp(u, grad(perm[A], x, y), grad(perm[B], x - 1, y));
+    const double n1 = lerp(u, grad(perm[A + 1], x, y - 1), grad(perm[B + 1], x - 1, y - 1));
+    return lerp(v, n0, n1);
+}
+
+double SyntheticScene::height(double x, double y) const
+{
+    double sum = 0, ampSum = 0;
+    double amp = 1, freq = NoiseFrequency;
+    for (int o = 0; o < NoiseOctaves; ++o)
+    {
+        sum += amp * noise(x * freq, y * freq);
+        ampSum += amp;
+        amp *= 0.5;
+        freq *= 2;
+    }
+    return sum / ampSum;
+}
+
+bool SyntheticScene::isLand(double x, double y) const
+{
+    return height(x, y) >= WaterLevel;
+}
+
+void SyntheticScene::setHeight(gdg::Point &p) const
+{
+    p._p[2] = TerrainRelief * height(p._p[0], p._p[1]);
+}
+
+void SyntheticScene::makeTerrainPoint(PhiloxRandGen &randGen, gdg::Point &p) const
+{
+    p._p[0] = randGen.getNext();
+    p._p[1] = randGen.getNext();
+    setHeight(p);
+}
+
+void SyntheticScene::makeVoidPoint(PhiloxRandGen &randGen, gdg::Point &p) const
+{
+    do
+    {
+        p._p[0] = randGen.getNext();
+        p._p[1] = randGen.getNext();
+    } while (!isLand(p._p[0], p._p[1]));
+    setHeight(p);
+}
+
+void SyntheticScene::makeClusterPoint(PhiloxRandGen &randGen, gdg::Point &p) const
+{
+    if (randGen.getNext() < GroundShare)
+    {
+        makeVoidPoint(randGen, p);
+        return;
+    }
+
+    const double   pick    = randGen.getNext();
+    const Cluster &cluster = *std::lower_bound(
+        clusters.begin(), clusters.end(), pick, [](const Cluster &c, double w) { return c.weight < w; });
+    do
+    {
+        // nextGaussian maps [-3, 3) sigma onto [0, 1)
+        double gx, gy;
+        randGen.nextGaussian(gx, gy);
+        p._p[0] = cluster.x + (gx * 6 - 3) * cluster.sigma;
+        p._p[1] = cluster.y + (gy * 6 - 3) * cluster.sigma;
+    } while (p._p[0] < 0 || p._p[0] >= 1 || p._p[1] < 0 || p._p[1] >= 1 || !isLand(p._p[0], p._p[1]));
+    setHeight(p);
+    p._p[2] += CanopyHeight * randGen.getNext();
+}
+
+void SyntheticScene::makeSwathPoint(PhiloxRandGen &randGen, gdg::Point &p) const
+{
+    // Flight lines run along x; a swath is swept by scan lines across it
+    const double width = swathWidth(swathNum);
+    do
+    {
+        const int    swath  = std::min(swathNum - 1, static_cast<int>(randGen.getNext() * swathNum));
+        const int    line   = std::min(lineNum - 1, static_cast<int>(randGen.getNext() * lineNum));
+        const double across = randGen.getNext() - 0.5;
+
+        // The scanner sweeps back and forth, so lines zigzag along the track
+        const double skew   = (line % 2 == 0 ? across : -across) * ScanSkew;
+        const double jitter = (randGen.getNext() - 0.5) * ScanJitter;
+        p._p[0]             = (line + 0.5 + skew + jitter) / lineNum;
+        p._p[1]             = (swath + 0.5) / swathNum + across * width;
+    } while (p._p[0] < 0 || p._p[0] >= 1 || p._p[1] < 0 || p._p[1] >= 1 || !isLand(p._p[0], p._p[1]));
+    setHeight(p);
+}
@@ -1,7 +1,11 @@
 #include "../inc/TriangulationHandler.h"
+#include "../inc/json.h"
 #include <unistd.h>
 #include <yaml-cpp/yaml.h>
-#include "../inc/json.h"
+#include "include/GlbFile.h"
+#include "include/MeshSnapshot.h"
+#include "include/ObjFile.h"
+#include "include/PlyFile.h"
 
 TriangulationHandler::TriangulationHandler(const char *InputYAMLFile)
 {
@@ -10,7 +14,18 @@ TriangulationHandler::TriangulationHandler(const char *InputYAMLFile)
     YAML::Node config = YAML::LoadFile(InputYAMLFile);
 
     runNum  = config["RunNum"].as<int>();
+    if (config["WarmupRuns"])
+        warmupNum = std::max(0, config["WarmupRuns"].as<int>());
+    statHistory = gdg::StatisticsHistory(warmupNum);
+    if (config["StatsPath"])
+        statsFilename = config["StatsPath"].as<std::string>();
     doCheck = config["DoCheck"].as<bool>();
+    if (config["CheckSampled"])
+    {
+        checkSampled                 = config["CheckSampled"].as<bool>();
+        sampleCheckOption.confidence = config["CheckConfidence"].as<double>();
+        sampleCheckOption.tolerance  = config["CheckTolerance"].as<double>();
+    }
 
     InputGeneratorOption inputGeneratorOption;
     inputGeneratorOption.inputFromFile = config["InputFromFile"].as<bool>();
@@ -31,26 +46,60 @@ TriangulationHandler::TriangulationHandler(const char *InputYAMLFile)
         {
             inputGeneratorOption.inputConstraint = true;
         }
+        if (config["LasClassifications"])
+        {
+            auto &lasFilter           = inputGeneratorOption.lasFilter;
+            lasFilter.classifications = config["LasClassifications"].as<std::vector<int>>();
+            lasFilter.returnNumbers   = config["LasReturnNumbers"].as<std::vector<int>>();
+            lasFilter.lastReturnOnly  = config["LasLastReturnOnly"].as<bool>();
+        }
     }
     else
     {
         inputGeneratorOption.pointNum = config["PointNum"].as<int>();
         inputGeneratorOption.setDistributionFromStr(config["DistributionType"].as<std::string>());
         inputGeneratorOption.seed = config["Seed"].as<int>();
+        if (config["LegacyRandom"])
+            inputGeneratorOption.legacyRandom = config["LegacyRandom"].as<bool>();
+        if (config["ConstraintType"])
+        {
+            auto &constraintOption = inputGeneratorOption.constraintOption;
+            constraintOption.setShapeFromStr(config["ConstraintType"].as<std::string>());
+            constraintOption.constraintNum = config["ConstraintNum"].as<int>();
+            constraintOption.segmentNum    = config["ConstraintSegments"].as<int>();
+        }
     }
     inputGeneratorOption.saveToFile   = config["SaveToFile"].as<bool>();
     inputGeneratorOption.saveFilename = config["SavePath"].as<std::string>();
 
-    auto           timer = (double)clock();
-    InputGenerator inputGenerator(inputGeneratorOption, input);
-    inputGenerator.generateInput();
-    std::cout << "Point generating time: " << ((double)clock() - timer) / CLOCKS_PER_SEC << std::endl;
+    if (inputGeneratorOption.inputFromFile && gdg::isMeshSnapshot(inputGeneratorOption.inputFilename))
+    {
+        // A snapshot already holds the triangulation, so only checks and output run
+        gdg::loadMeshSnapshot(inputGeneratorOption.inputFilename, input, output);
+        meshLoaded = true;
+    }
+    else if (inputGeneratorOption.inputFromFile && gdg::isCompactMesh(inputGeneratorOption.inputFilename))
+    {
+        gdg::readCompactMesh(inputGeneratorOption.inputFilename, input, output);
+        meshLoaded = true;
+    }
+    else
+    {
+        auto           timer = (double)clock();
+        InputGenerator inputGenerator(inputGeneratorOption, input);
+        inputGenerator.generateInput();
+        std::cout << "Point generating time: " << ((double)clock() - timer) / CLOCKS_PER_SEC << std::endl;
+    }
     input.insAll    = config["InsertAll"].as<bool>();
     input.noSort    = config["NoSortPoint"].as<bool>();
     input.noReorder = config["NoReorder"].as<bool>();
 
     outputResult   = config["OutputTriangles"].as<bool>();
     OutputFilename = config["OutputTrianglePath"].as<std::string>();
+    outputOption.readFromConfig(config);
+    if (config["SaveSnapshotPath"])
+        snapshotFilename = config["SaveSnapshotPath"].as<std::string>();
+    resultCache = openResultCache(config);
 }
 
 void TriangulationHandler::reset()
@@ -59,26 +108,70 @@ void TriangulationHandler::reset()
     gdg::TriOppHVec().swap(output.triOppVec);
 }
 
+void TriangulationHandler::check(int runIdx)
+{
+    gdg::DelaunayChecker checker(input, output);
+    std::cout << "\n*** Check ***\n";
+    if (checkSampled)
+    {
+        // Draw a different sample on every run
+        gdg::SampleCheckOption option = sampleCheckOption;
+        option.seed += runIdx;
+        checker.checkSampled(option);
+        return;
+    }
+    checker.checkEuler();
+    checker.checkOrientation();
+    checker.checkAdjacency();
+    checker.checkConstraints();
+    checker.checkDelaunay();
+}
+
 void TriangulationHandler::run()
 {
-    gdg::GpuDel gpuDel;
-    for (int i = 0; i < runNum; ++i)
+    // A cached result stands for all runs
+    gdg::ResultCacheKey cacheKey{};
+    bool                cacheHit = false;
+    if (!meshLoaded && resultCache)
+    {
+        cacheKey = gdg::makeResultCacheKey(input);
+        cacheHit = resultCache->load(cacheKey, output);
+    }
+
+    if (meshLoaded || cacheHit)
     {
-        reset();
-        gpuDel.compute(input, output);
-        statSum.accumulate(gpuDel.getStatistics());
         if (doCheck)
+            check(0);
+    }
+    else
+    {
+        gdg::GpuDel gpuDel;
+        for (int i = 0; i < warmupNum + runNum; ++i)
+        {
+            reset();
+            gpuDel.compute(input, output);
+            statHistory.add(gpuDel.getStatistics());
+            if (doCheck && i >= warmupNum)
+                check(i - warmupNum);
+        }
+
+        if (resultCache)
         {
-            gdg::DelaunayChecker checker(input, output);
-            std::cout << "\n*** Check ***\n";
-            checker.checkEuler();
-            checker.checkOrientation();
-            checker.checkAdjacency();
-            checker.checkConstraints();
-            checker.checkDelaunay();
+            try
+            {
+                resultCache->store(cacheKey, output);
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << e.what() << std::endl;
+            }
         }
     }
-    statSum.average(runNum);
+
+    if (!snapshotFilename.empty())
+    {
+        gdg::saveMeshSnapshot(snapshotFilename, input, output);
+    }
 
     if (outputResult)
     {
@@ -88,102 +181,108 @@ void TriangulationHandler::run()
     std::cout << std::endl;
     std::cout << "---- SUMMARY ----" << std::endl;
     std::cout << std::endl;
-    std::cout << "PointNum       " << input.pointVec.size() << std::endl;
+    std::cout << "PointNum       " << input.pointNum() << std::endl;
     std::cout << "Sort           " << (input.noSort ? "no" : "yes") << std::endl;
     std::cout << "Reorder        " << (input.noReorder ? "no" : "yes") << std::endl;
     std::cout << "Insert mode    " << (input.insAll ? "InsAll" : "InsFlip") << std::endl;
     std::cout << std::endl;
+    const gdg::StatisticsSummary summary = statHistory.summarize();
     std::cout << std::fixed << std::right << std::setprecision(2);
-    std::cout << "Time used (ms)" << std::endl;
-    std::cout << "TotalTime      " << std::setw(10) << statSum.totalTime << std::endl;
-    std::cout << "InitTime       " << std::setw(10) << statSum.initTime << std::endl;
-    std::cout << "SplitTime      " << std::setw(10) << statSum.splitTime << std::endl;
-    std::cout << "FlipTime       " << std::setw(10) << statSum.flipTime << std::endl;
-    std::cout << "RelocateTime   " << std::setw(10) << statSum.relocateTime << std::endl;
-    std::cout << "SortTime       " << std::setw(10) << statSum.sortTime << std::endl;
-    std::cout << "ConstraintTime " << std::setw(10) << statSum.constraintTime << std::endl;
-    std::cout << "OutTime        " << std::setw(10) << statSum.outTime << std::endl;
+    std::cout << "Time used (ms) over " << statHistory.runNum() << " runs, " << statHistory.warmupRunNum()
+              << " warm-up runs excluded" << std::endl;
+    std::cout << "               ";
+    for (int f = 0; f < gdg::StatisticsSummaryFieldNum; ++f)
+        std::cout << std::setw(10) << gdg::statisticsSummaryFields()[f].name;
     std::cout << std::endl;
+    for (int s = 0; s < gdg::StatisticsStageNum; ++s)
+    {
+        const gdg::StatisticsStage &stage = gdg::statisticsStages()[s];
+        std::cout << std::left << std::setw(15) << stage.name << std::right;
+        for (int f = 0; f < gdg::StatisticsSummaryFieldNum; ++f)
+            std::cout << std::setw(10) << (summary.*gdg::statisticsSummaryFields()[f].value).*stage.time;
+        std::cout << std::endl;
+    }
+    std::cout << std::endl;
+    if (!statsFilename.empty())
+        saveStatsToFile(summary);
+    if (resultCache)
+        printResultCacheStats(*resultCache);
 }
 
 void TriangulationHandler::saveResultsToFile()
 {
-    std::ofstream outputTri(OutputFilename);
-    if (outputTri.is_open())
+    try
     {
-        std::size_t found = OutputFilename.find_last_of('.');
-        std::string extension = OutputFilename.substr(found + 1, OutputFilename.size() - found);
-        if ( extension == "obj")
-        {
-            saveToObj(outputTri);
-        }
-        else if(extension == "geojson")
-        {
-            saveToGeojson(outputTri);
-        }
-        else{
-            std::cerr << "Can't identify the saving file's extension!" << std::endl;
-        }
-        outputTri.close();
+        saveMesh(OutputFilename, input, output, outputOption);
     }
-    else
+    catch (const std::exception &e)
     {
-        std::cerr << "Delaunay triangulation saving path " << OutputFilename << " is not valid! will not save..."
-                  << std::endl;
+        std::cerr << e.what() << std::endl;
     }
 }
 
-void TriangulationHandler::saveToGeojson(std::ofstream &outputTri) const{
-    nlohmann::json JsonFile;
-    JsonFile["type"]                      = "FeatureCollection";
-    JsonFile["name"]                      = "left_4_edge_polygon";
-    JsonFile["crs"]["type"]               = "name";
-    JsonFile["crs"]["properties"]["name"] = "urn:ogc:def:crs:EPSG::32601";
-    JsonFile["features"]                  = nlohmann::json::array();
-    for (auto &tri : output.triVec)
-    {
-        nlohmann::json Coor = nlohmann::json::array();
-        Coor.push_back({input.pointVec[tri._v[0]]._p[0],
-                        input.pointVec[tri._v[0]]._p[1],
-                        input.pointVec[tri._v[0]]._p[2]});
-        Coor.push_back({input.pointVec[tri._v[1]]._p[0],
-                        input.pointVec[tri._v[1]]._p[1],
-                        input.pointVec[tri._v[1]]._p[2]});
-        Coor.push_back({input.pointVec[tri._v[2]]._p[0],
-                        input.pointVec[tri._v[2]]._p[1],
-                        input.pointVec[tri._v[2]]._p[2]});
-        nlohmann::json CoorWrapper = nlohmann::json::array();
-        CoorWrapper.push_back(Coor);
-        nlohmann::json TriangleObject;
-        TriangleObject["type"]       = "Feature";
-        TriangleObject["properties"] = {{"v0", tri._v[0]}, {"v1", tri._v[1]}, {"v2", tri._v[2]}};
-        TriangleObject["geometry"]   = {{"type", "Polygon"}, {"coordinates", CoorWrapper}};
-        JsonFile["features"].push_back(TriangleObject);
-    }
-    outputTri << JsonFile << std::endl;
+void MeshOutputOption::readFromConfig(const YAML::Node &config)
+{
+    if (config["OutputObjColor"])
+        objColor = config["OutputObjColor"].as<bool>();
+    if (config["OutputGeojsonName"])
+    {
+        geojson.name = config["OutputGeojsonName"].as<std::string>();
+        geojson.crs  = config["OutputGeojsonCrs"].as<std::string>();
+    }
+    if (config["OutputGlbQuantize"])
+        glb.quantize = config["OutputGlbQuantize"].as<bool>();
+    if (config["OutputCompactStep"])
+        compact.step = config["OutputCompactStep"].as<double>();
+}
+
+std::unique_ptr<gdg::ResultCache> openResultCache(const YAML::Node &config)
+{
+    if (!config["ResultCacheDir"] || config["ResultCacheDir"].as<std::string>().empty())
+        return nullptr;
+    const uint64_t capacity = config["ResultCacheSizeMB"].as<uint64_t>() << 20;
+    return std::make_unique<gdg::ResultCache>(config["ResultCacheDir"].as<std::string>(), capacity);
+}
+
+void printResultCacheStats(const gdg::ResultCache &resultCache)
+{
+    const gdg::ResultCacheStats &stats = resultCache.stats();
+    std::cout << "Result cache" << std::endl;
+    std::cout << "CacheHit       " << std::setw(10) << stats.hitNum << std::endl;
+    std::cout << "CacheMiss      " << std::setw(10) << stats.missNum << std::endl;
+    std::cout << "CacheEvict     " << std::setw(10) << stats.evictNum << std::endl;
+    std::cout << std::endl;
 }
 
-void TriangulationHandler::saveToObj(std::ofstream &outputTri) const{
-    outputTri << std::setprecision(12);
-    double colors[5][3] = {
-        {0.8, 0.2, 0.2},  // Red
-        {0.9, 0.6, 0.2},  // Orange
-        {0.2, 0.8, 0.2},  // Green
-        {0.2, 0.6, 0.9},  // Sky Blue
-        {0.6, 0.2, 0.8}   // Purple
-    };
-    int i = 0;
-    for (const auto &pt : input.pointVec)
+void saveMesh(const std::string      &filename,
+              const gdg::Input       &input,
+              const gdg::Output      &output,
+              const MeshOutputOption &option)
+{
+    const std::size_t found     = filename.find_last_of('.');
+    const std::string extension = (found == std::string::npos) ? "" : filename.substr(found + 1);
+    if (extension != "obj" && extension != "geojson" && extension != "ply" && extension != "glb" &&
+        extension != "gdc")
     {
-        double *color = colors[i % 5];
-        outputTri << "v " << pt._p[0] << " " << pt._p[1] << " " << pt._p[2] << " " << color[0] << " "
-                  << color[1] << " " << color[2] << std::endl;
-        ++i;
+        throw std::invalid_argument("Can't identify the extension of saving file " + filename);
     }
-    for (auto &tri : output.triVec)
+
+    std::ofstream outputTri(filename, std::ios::binary);
+    if (!outputTri.is_open())
     {
-        outputTri << "f " << tri._v[0] + 1 << " " << tri._v[1] + 1 << " " << tri._v[2] + 1 << std::endl;
+        throw std::runtime_error("Delaunay triangulation saving path " + filename + " is not valid! will not save...");
     }
+
+    if (extension == "obj")
+        gdg::writeObj(outputTri, input.points(), input.pointNum(), output.tris(), output.triNum(), option.objColor);
+    else if (extension == "geojson")
+        gdg::writeGeojson(outputTri, input.points(), output.tris(), output.triNum(), option.geojson);
+    else if (extension == "ply")
+        gdg::writePly(outputTri, input.points(), input.pointNum(), output.tris(), output.triNum());
+    else if (extension == "glb")
+        gdg::writeGlb(outputTri, input.points(), input.pointNum(), output.tris(), output.triNum(), option.glb);
+    else
+        gdg::writeCompactMesh(outputTri, input, output, option.compact);
 }
 
 bool TriangulationHandler::checkInside(gdg::Tri &t, gdg::Point p) const
@@ -193,7 +292,7 @@ bool TriangulationHandler::checkInside(gdg::Tri &t, gdg::Point p) const
     int  count  = 0;
     for (auto i : gdg::TriSeg)
     {
-        line side = {input.pointVec[t._v[i[0]]], input.pointVec[t._v[i[1]]]};
+        line side = {input.points()[t._v[i[0]]], input.points()[t._v[i[1]]]};
         if (isIntersect(side, exline))
         {
             // If side intersects exline
@@ -204,4 +303,36 @@ bool TriangulationHandler::checkInside(gdg::Tri &t, gdg::Point p) const
     }
     // When count is odd
     return count & 1;
+}
+
+void TriangulationHandler::saveStatsToFile(const gdg::StatisticsSummary &summary) const
+{
+    nlohmann::ordered_json json;
+    json["pointNum"]      = input.pointNum();
+    json["constraintNum"] = input.constraintNum();
+    json["insertAll"]     = input.insAll;
+    json["noSortPoint"]   = input.noSort;
+    json["noReorder"]     = input.noReorder;
+    json["runs"]          = statHistory.runNum();
+    json["warmupRuns"]    = statHistory.warmupRunNum();
+    for (int s = 0; s < gdg::StatisticsStageNum; ++s)
+    {
+        const gdg::StatisticsStage &stage = gdg::statisticsStages()[s];
+        nlohmann::ordered_json      item;
+        for (int f = 0; f < gdg::StatisticsSummaryFieldNum; ++f)
+        {
+            const gdg::StatisticsSummaryField &field = gdg::statisticsSummaryFields()[f];
+            item[field.name]                         = (summary.*field.value).*stage.time;
+        }
+        item["Samples"]            = statHistory.samples(stage.time);
+        json["timeMs"][stage.name] = item;
+    }
+
+    std::ofstream file(statsFilename);
+    if (!file.is_open())
+    {
+        std::cerr << "Stats path " << statsFilename << " is not valid! will not save..." << std::endl;
+        return;
+    }
+    file << json.dump(2) << std::endl;
 }
\ No newline at end of file
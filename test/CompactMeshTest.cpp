@@ -0,0 +1,132 @@
+#include "gpu-delaunay-generator.h"
+#include "include/CompactMesh.h"
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <random>
+
+namespace
+{
+constexpr int GridSize  = 24;
+constexpr int FlipSeeds = 500;
+
+// Grid of GridSize x GridSize points split by diagonals, with a hole so the
+// archive holds split and cap symbols too
+void makeMesh(gdg::Input &input, gdg::Output &output)
+{
+    for (int j = 0; j < GridSize; ++j)
+        for (int i = 0; i < GridSize; ++i)
+            input.pointVec.push_back(gdg::Point(i, j, 0.1 * ((i * 7 + j * 3) % 5)));
+
+    auto id = [](int i, int j) { return j * GridSize + i; };
+    for (int j = 0; j < GridSize - 1; ++j)
+    {
+        for (int i = 0; i < GridSize - 1; ++i)
+        {
+            if (i >= 8 && i < 12 && j >= 8 && j < 12)
+                continue;
+            output.triVec.push_back(gdg::Tri(id(i, j), id(i + 1, j), id(i + 1, j + 1)));
+            output.triVec.push_back(gdg::Tri(id(i, j), id(i + 1, j + 1), id(i, j + 1)));
+        }
+    }
+
+    std::map<std::pair<int, int>, std::pair<int, int>> edgeMap;
+    output.triOppVec.resize(output.triVec.size());
+    for (int t = 0; t < (int)output.triVec.size(); ++t)
+    {
+        for (int vi = 0; vi < 3; ++vi)
+        {
+            const gdg::Tri &tri = output.triVec[t];
+            edgeMap[{tri._v[(vi + 1) % 3], tri._v[(vi + 2) % 3]}] = {t, vi};
+            output.triOppVec[t]._t[vi]                            = -1;
+        }
+    }
+    for (int t = 0; t < (int)output.triVec.size(); ++t)
+    {
+        for (int vi = 0; vi < 3; ++vi)
+        {
+            const gdg::Tri &tri = output.triVec[t];
+            const auto      it  = edgeMap.find({tri._v[(vi + 2) % 3], tri._v[(vi + 1) % 3]});
+            if (it != edgeMap.end())
+                output.triOppVec[t].setOpp(vi, it->second.first, it->second.second);
+        }
+    }
+    input.constraintVec.push_back({id(0, 0), id(1, 0)});
+    output.infPt = gdg::Point(GridSize / 2.0, GridSize / 2.0, 0);
+}
+
+void writeFile(const std::string &filename, const std::string &data, size_t size)
+{
+    std::ofstream file(filename, std::ios::binary);
+    file.write(data.data(), static_cast<std::streamsize>(size));
+}
+
+// Loading must either succeed or throw std::runtime_error; returns true if it threw
+bool load(const std::string &filename)
+{
+    gdg::Input  input;
+    gdg::Output output;
+    try
+    {
+        gdg::readCompactMesh(filename, input, output);
+    }
+    catch (const std::runtime_error &)
+    {
+        return true;
+    }
+    return false;
+}
+}
+
+int main()
+{
+    gdg::Input  input;
+    gdg::Output output;
+    makeMesh(input, output);
+
+    std::ostringstream archive;
+    gdg::writeCompactMesh(archive, input, output);
+    const std::string data     = archive.str();
+    const std::string filename = (std::filesystem::temp_directory_path() / "gdg-compact-mesh-test.gdc").string();
+
+    int failNum = 0;
+
+    writeFile(filename, data, data.size());
+    if (load(filename))
+    {
+        std::cerr << "Valid archive did not load" << std::endl;
+        ++failNum;
+    }
+
+    // Every truncation must be reported
+    for (size_t size : {size_t(0), size_t(16), data.size() / 4, data.size() / 2, data.size() - 1})
+    {
+        writeFile(filename, data, size);
+        if (!load(filename))
+        {
+            std::cerr << "Archive truncated to " << size << " bytes loaded" << std::endl;
+            ++failNum;
+        }
+    }
+
+    // Flipped bits may still decode, but must not corrupt memory
+    int thrownNum = 0;
+    for (int seed = 0; seed < FlipSeeds; ++seed)
+    {
+        std::mt19937 rng(seed);
+        std::string  flipped = data;
+        const int    flipNum = 1 + static_cast<int>(rng() % 8);
+        for (int f = 0; f < flipNum; ++f)
+        {
+            const size_t bit = rng() % (8 * flipped.size());
+            flipped[bit / 8] = static_cast<char>(flipped[bit / 8] ^ (1 << (bit % 8)));
+        }
+        writeFile(filename, flipped, flipped.size());
+        thrownNum += load(filename);
+    }
+
+    std::filesystem::remove(filename);
+    std::cout << "Bit-flipped archives rejected: " << thrownNum << " / " << FlipSeeds << std::endl;
+    std::cout << (failNum == 0 ? "PASS" : "FAIL") << std::endl;
+    return failNum == 0 ? 0 : 1;
+}